@@ -0,0 +1,161 @@
+#ifndef QUIKMAFF_ARENA_HPP
+#define QUIKMAFF_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "base.hpp"
+
+namespace qm {
+
+/**
+ * @brief A bump allocator for short-lived, bulk-freed data.
+ *
+ * Allocations are carved sequentially out of large blocks and individual deallocations are
+ * ignored. reset() releases everything at once but keeps the blocks, so a workload repeated
+ * every frame or tile stops touching the heap once the arena has grown to its peak size.
+ *
+ * The arena is a std::pmr::memory_resource, so standard containers can allocate from it through
+ * std::pmr::polymorphic_allocator.
+ *
+ * Example usage:
+ * @code
+ * qm::Arena arena;
+ * for (const Tile &tile : tiles) {
+ *     arena.reset();
+ *     std::pmr::vector<vec2<f32>> points(&arena);
+ *     // ... everything allocated here is released by the next reset
+ * }
+ * @endcode
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Constructs an empty arena.
+     * @param blockSize Size in bytes of each block requested from the upstream resource. Larger
+     * allocations get a block of their own.
+     * @param upstream The resource blocks are requested from.
+     */
+    explicit Arena(std::size_t blockSize = 64 * 1024,
+                   std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : m_blockSize{blockSize}, m_upstream{upstream}
+    {
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() override
+    {
+        for (const Block &block : m_blocks) {
+            m_upstream->deallocate(block.Data, block.Size, alignof(std::max_align_t));
+        }
+    }
+
+    /**
+     * @brief Releases every allocation at once, keeping the blocks for reuse.
+     */
+    void reset()
+    {
+        m_current = 0;
+        m_offset = 0;
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for an array.
+     * @tparam T The element type; must be trivially destructible, as the arena never runs
+     * destructors.
+     * @param count Number of elements.
+     * @return The storage.
+     */
+    template <typename T>
+    std::span<T> allocateArray(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        return {static_cast<T *>(allocate(count * sizeof(T), alignof(T))), count};
+    }
+
+    /**
+     * @brief Returns the number of bytes handed out since the last reset, including padding.
+     */
+    std::size_t bytesUsed() const
+    {
+        std::size_t used = m_offset;
+        for (std::size_t i = 0; i < m_current && i < m_blocks.size(); ++i) {
+            used += m_blocks[i].Size;
+        }
+        return used;
+    }
+
+    /**
+     * @brief Returns the total size of the blocks held by the arena.
+     */
+    std::size_t capacity() const
+    {
+        std::size_t total = 0;
+        for (const Block &block : m_blocks) {
+            total += block.Size;
+        }
+        return total;
+    }
+
+private:
+    struct Block {
+        std::byte *Data;
+        std::size_t Size;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        // Move on through the retained blocks until one has room
+        while (m_current < m_blocks.size()) {
+            if (void *result = carve(m_blocks[m_current], bytes, alignment)) {
+                return result;
+            }
+            ++m_current;
+            m_offset = 0;
+        }
+
+        const std::size_t size = bytes + alignment > m_blockSize ? bytes + alignment : m_blockSize;
+        void *memory = m_upstream->allocate(size, alignof(std::max_align_t));
+        m_blocks.push_back({static_cast<std::byte *>(memory), size});
+        m_current = m_blocks.size() - 1;
+        m_offset = 0;
+        return carve(m_blocks.back(), bytes, alignment);
+    }
+
+    // Bumps the offset within a block, or returns nullptr if the allocation does not fit.
+    void *carve(const Block &block, std::size_t bytes, std::size_t alignment)
+    {
+        const auto base = reinterpret_cast<std::uintptr_t>(block.Data);
+        const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(alignment - 1);
+        const std::size_t end = static_cast<std::size_t>(aligned - base) + bytes;
+        if (end > block.Size) {
+            return nullptr;
+        }
+        m_offset = end;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    std::size_t m_blockSize;
+    std::pmr::memory_resource *m_upstream;
+    std::vector<Block> m_blocks;
+    std::size_t m_current = 0;
+    std::size_t m_offset = 0;
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_ARENA_HPP
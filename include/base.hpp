@@ -26,6 +26,23 @@
 #define QM_INLINE inline
 #endif
 
+// Instruction sets
+#if defined(__BMI2__)
+#define QM_BMI2
+#endif
+
+#if defined(__AVX2__)
+#define QM_AVX2
+#endif
+
+#if defined(__F16C__)
+#define QM_F16C
+#endif
+
+#if defined(__FMA__)
+#define QM_FMA
+#endif
+
 // Assertions
 #define QM_STATIC_ASSERT(expr) static_assert(expr, "static assert failed: " #expr);
 
@@ -0,0 +1,495 @@
+#ifndef QUIKMAFF_BVH_HPP
+#define QUIKMAFF_BVH_HPP
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "intersect.hpp"
+
+namespace qm {
+
+/**
+ * @brief Closest hit returned by a TriangleBVH query.
+ */
+struct TriangleHit {
+    f32 t;        ///< Distance along the ray (in units of the direction length)
+    f32 u;        ///< Barycentric weight of the triangle's second vertex (raycasts only)
+    f32 v;        ///< Barycentric weight of the triangle's third vertex (raycasts only)
+    u32 triangle; ///< Index of the triangle in the source index buffer (index / 3)
+};
+
+/**
+ * @brief A 4-wide bounding volume hierarchy over a static triangle soup with quantized bounds.
+ *
+ * Each node stores the bounds of its four children as 16-bit offsets relative to the node's own
+ * bounds, which brings a node down to 92 bytes. Typical meshes need one node per six to eight
+ * triangles, so the acceleration structure takes roughly 16 to 20 bytes per triangle including
+ * the 4-byte triangle ordering. Vertex and index data are referenced, not copied, and must
+ * outlive the BVH.
+ *
+ * Example usage:
+ * @code
+ * qm::TriangleBVH bvh;
+ * bvh.build(vertices, indices);
+ *
+ * qm::TriangleHit hit;
+ * if (bvh.raycast(origin, direction, 1000.0f, hit)) {
+ *     // hit.triangle, hit.t ...
+ * }
+ * @endcode
+ */
+class TriangleBVH {
+public:
+    /**
+     * @brief Maximum number of triangles stored in a leaf.
+     */
+    static constexpr u32 MaxLeafSize = 4;
+
+    /**
+     * @brief Builds the hierarchy over an indexed triangle list.
+     * @param vertices Vertex positions.
+     * @param indices Triangle indices, three per triangle.
+     */
+    void build(std::span<const vec3<f32>> vertices, std::span<const u32> indices)
+    {
+        QM_ASSERT(indices.size() % 3 == 0);
+
+        m_vertices = vertices;
+        m_indices = indices;
+        m_nodes.clear();
+
+        const u32 triangleCount = static_cast<u32>(indices.size() / 3);
+        m_triangles.resize(triangleCount);
+
+        if (triangleCount == 0) {
+            m_triangles.shrink_to_fit();
+            return;
+        }
+
+        // Per-triangle bounds and centroids are only needed while building
+        std::vector<BuildPrimitive> primitives(triangleCount);
+        for (u32 i = 0; i < triangleCount; ++i) {
+            const vec3<f32> &a = vertex(i, 0);
+            const vec3<f32> &b = vertex(i, 1);
+            const vec3<f32> &c = vertex(i, 2);
+
+            BuildPrimitive &primitive = primitives[i];
+            primitive.Box.Min = vec3<f32>(qm::min({a.x, b.x, c.x}), qm::min({a.y, b.y, c.y}),
+                                             qm::min({a.z, b.z, c.z}));
+            primitive.Box.Max = vec3<f32>(qm::max({a.x, b.x, c.x}), qm::max({a.y, b.y, c.y}),
+                                             qm::max({a.z, b.z, c.z}));
+            primitive.Centroid = (primitive.Box.Min + primitive.Box.Max) * 0.5f;
+            primitive.Triangle = i;
+        }
+
+        m_nodes.reserve(triangleCount / 8 + 1);
+        buildNode(primitives, 0, triangleCount, 0);
+
+        for (u32 i = 0; i < triangleCount; ++i) {
+            m_triangles[i] = primitives[i].Triangle;
+        }
+        m_nodes.shrink_to_fit();
+    }
+
+    /**
+     * @brief Finds the closest triangle hit along a ray.
+     * @param origin Origin of the ray.
+     * @param direction Direction of the ray.
+     * @param maxDistance Largest distance along the ray to consider.
+     * @param hit Receives the closest hit.
+     * @return True if any triangle was hit within maxDistance.
+     */
+    bool raycast(const vec3<f32> &origin, const vec3<f32> &direction, f32 maxDistance,
+                 TriangleHit &hit) const
+    {
+        return traverse(origin, direction, 0.0f, maxDistance, hit,
+                        [&](u32 triangle, f32 &t, f32 &u, f32 &v) {
+                            return rayTriangleIntersect(origin, direction, vertex(triangle, 0),
+                                                        vertex(triangle, 1), vertex(triangle, 2),
+                                                        t, u, v);
+                        });
+    }
+
+    /**
+     * @brief Sweeps a sphere along a ray and finds the first triangle it touches.
+     * @param origin Starting centre of the sphere.
+     * @param direction Direction of travel.
+     * @param radius Radius of the sphere.
+     * @param maxDistance Largest distance along the ray to consider.
+     * @param hit Receives the first contact; u and v are left at zero.
+     * @return True if any triangle was touched within maxDistance.
+     */
+    bool sphereSweep(const vec3<f32> &origin, const vec3<f32> &direction, f32 radius,
+                     f32 maxDistance, TriangleHit &hit) const
+    {
+        return traverse(origin, direction, radius, maxDistance, hit,
+                        [&](u32 triangle, f32 &t, f32 &u, f32 &v) {
+                            u = 0.0f;
+                            v = 0.0f;
+                            return sphereSweepTriangle(origin, direction, radius,
+                                                       vertex(triangle, 0), vertex(triangle, 1),
+                                                       vertex(triangle, 2), t);
+                        });
+    }
+
+    /**
+     * @brief Returns the number of nodes in the hierarchy.
+     */
+    std::size_t nodeCount() const { return m_nodes.size(); }
+
+    /**
+     * @brief Returns the memory used by the acceleration structure in bytes, excluding the
+     * referenced vertex and index data.
+     */
+    std::size_t memoryUsage() const
+    {
+        return m_nodes.size() * sizeof(Node) + m_triangles.size() * sizeof(u32);
+    }
+
+private:
+    struct Bounds {
+        vec3<f32> Min{std::numeric_limits<f32>::max()};
+        vec3<f32> Max{std::numeric_limits<f32>::lowest()};
+
+        void grow(const Bounds &other)
+        {
+            for (u32 axis = 0; axis < 3; ++axis) {
+                Min[axis] = qm::min(Min[axis], other.Min[axis]);
+                Max[axis] = qm::max(Max[axis], other.Max[axis]);
+            }
+        }
+    };
+
+    struct BuildPrimitive {
+        Bounds Box;
+        vec3<f32> Centroid;
+        u32 Triangle;
+    };
+
+    /**
+     * @brief A 4-wide node whose child bounds are quantized against the node's own bounds.
+     */
+    struct Node {
+        f32 Origin[3];        // Minimum corner of the node
+        f32 Scale[3];         // Size of one quantization step per axis
+        u16 ChildMin[3][4];   // Quantized child minimum, per axis then per child
+        u16 ChildMax[3][4];   // Quantized child maximum, per axis then per child
+        u32 Child[4];         // Node index for inner children, first triangle for leaves
+        u8 Count[4];          // 0 for inner children, EmptySlot for unused, else triangle count
+    };
+
+    static constexpr u8 EmptySlot = 0xFF;
+    static constexpr u32 StackSize = 128;
+
+    // Nodes this deep split at the centroid median instead of by area, which leaves each child at
+    // most a quarter of its parent's triangles. Fewer than 4^16 triangles therefore cannot put an
+    // inner node deeper than MaxSahDepth + 14, however lopsided the area splits above were.
+    static constexpr u32 MaxSahDepth = 24;
+    static constexpr u32 MaxDepth = MaxSahDepth + 14;
+
+    // Traversal keeps at most three pending siblings per level, plus the four children pushed by
+    // the deepest parent of an inner node
+    static_assert(3 * (MaxDepth - 1) + 4 <= StackSize);
+    static constexpr f32 QuantizationSteps = 65535.0f;
+
+    const vec3<f32> &vertex(u32 triangle, u32 corner) const
+    {
+        return m_vertices[m_indices[triangle * 3 + corner]];
+    }
+
+    static Bounds rangeBounds(const std::vector<BuildPrimitive> &primitives, u32 first, u32 count,
+                              bool centroids)
+    {
+        Bounds bounds;
+        for (u32 i = first; i < first + count; ++i) {
+            if (centroids) {
+                bounds.grow({primitives[i].Centroid, primitives[i].Centroid});
+            }
+            else {
+                bounds.grow(primitives[i].Box);
+            }
+        }
+        return bounds;
+    }
+
+    static f32 surfaceArea(const Bounds &bounds)
+    {
+        const vec3<f32> extent = bounds.Max - bounds.Min;
+        return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+    }
+
+    // Partitions a range with a binned surface area heuristic, returning the size of the left
+    // part. Falls back to a centroid median split when useSah is false or the centroids cannot
+    // be separated.
+    static u32 splitRange(std::vector<BuildPrimitive> &primitives, u32 first, u32 count,
+                          bool useSah)
+    {
+        constexpr u32 binCount = 16;
+
+        const Bounds centroids = rangeBounds(primitives, first, count, true);
+        const vec3<f32> extent = centroids.Max - centroids.Min;
+        const u32 axis =
+            (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+        auto begin = primitives.begin() + first;
+
+        if (useSah && extent[axis] > 0.0f) {
+            Bounds bins[binCount];
+            u32 binSizes[binCount] = {};
+            const f32 binScale = binCount / extent[axis];
+            auto binOf = [&](const BuildPrimitive &primitive) {
+                const f32 offset = (primitive.Centroid[axis] - centroids.Min[axis]) * binScale;
+                return qm::min(static_cast<u32>(offset), binCount - 1);
+            };
+
+            for (u32 i = first; i < first + count; ++i) {
+                const u32 bin = binOf(primitives[i]);
+                bins[bin].grow(primitives[i].Box);
+                ++binSizes[bin];
+            }
+
+            // Sweep from the right to get the cost of every right-hand side
+            f32 rightCost[binCount];
+            Bounds right;
+            u32 rightSize = 0;
+            for (u32 bin = binCount - 1; bin > 0; --bin) {
+                right.grow(bins[bin]);
+                rightSize += binSizes[bin];
+                rightCost[bin] = rightSize > 0 ? surfaceArea(right) * rightSize : 0.0f;
+            }
+
+            Bounds left;
+            u32 leftSize = 0;
+            u32 bestBin = 0;
+            f32 bestCost = std::numeric_limits<f32>::max();
+            for (u32 bin = 1; bin < binCount; ++bin) {
+                left.grow(bins[bin - 1]);
+                leftSize += binSizes[bin - 1];
+                const f32 cost = (leftSize > 0 ? surfaceArea(left) * leftSize : 0.0f) +
+                                 rightCost[bin];
+                if (leftSize > 0 && leftSize < count && cost < bestCost) {
+                    bestCost = cost;
+                    bestBin = bin;
+                }
+            }
+
+            if (bestBin > 0) {
+                auto middle = std::partition(begin, begin + count, [&](const BuildPrimitive &p) {
+                    return binOf(p) < bestBin;
+                });
+                return static_cast<u32>(middle - begin);
+            }
+        }
+
+        const u32 half = count / 2;
+        std::nth_element(begin, begin + half, begin + count,
+                         [axis](const BuildPrimitive &a, const BuildPrimitive &b) {
+                             return a.Centroid[axis] < b.Centroid[axis];
+                         });
+        return half;
+    }
+
+    u32 buildNode(std::vector<BuildPrimitive> &primitives, u32 first, u32 count, u32 depth)
+    {
+        QM_ASSERT(depth <= MaxDepth);
+        const u32 nodeIndex = static_cast<u32>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        // Split the most populated range until there are four children
+        u32 rangeFirst[4] = {first};
+        u32 rangeCount[4] = {count};
+        u32 ranges = 1;
+
+        while (ranges < 4) {
+            u32 largest = 0;
+            for (u32 i = 1; i < ranges; ++i) {
+                if (rangeCount[i] > rangeCount[largest]) {
+                    largest = i;
+                }
+            }
+            if (rangeCount[largest] <= MaxLeafSize) {
+                break;
+            }
+
+            const u32 splitFirst = rangeFirst[largest];
+            const u32 splitCount = rangeCount[largest];
+            const u32 half = splitRange(primitives, splitFirst, splitCount, depth < MaxSahDepth);
+
+            rangeCount[largest] = half;
+            rangeFirst[ranges] = splitFirst + half;
+            rangeCount[ranges] = splitCount - half;
+            ++ranges;
+        }
+
+        Bounds childBounds[4];
+        Bounds nodeBounds;
+        for (u32 i = 0; i < ranges; ++i) {
+            childBounds[i] = rangeBounds(primitives, rangeFirst[i], rangeCount[i], false);
+            nodeBounds.grow(childBounds[i]);
+        }
+
+        u32 child[4];
+        u8 childCount[4];
+        for (u32 i = 0; i < 4; ++i) {
+            if (i >= ranges) {
+                child[i] = 0;
+                childCount[i] = EmptySlot;
+            }
+            else if (rangeCount[i] <= MaxLeafSize) {
+                child[i] = rangeFirst[i];
+                childCount[i] = static_cast<u8>(rangeCount[i]);
+            }
+            else {
+                // m_nodes may reallocate here, so the node is written afterwards
+                child[i] = buildNode(primitives, rangeFirst[i], rangeCount[i], depth + 1);
+                childCount[i] = 0;
+            }
+        }
+
+        Node &node = m_nodes[nodeIndex];
+        for (u32 axis = 0; axis < 3; ++axis) {
+            const f32 origin = nodeBounds.Min[axis];
+            const f32 scale = qm::max((nodeBounds.Max[axis] - origin) / QuantizationSteps,
+                                      std::numeric_limits<f32>::min());
+            node.Origin[axis] = origin;
+            node.Scale[axis] = scale;
+
+            for (u32 i = 0; i < 4; ++i) {
+                if (i >= ranges) {
+                    // An inverted box that no ray can enter
+                    node.ChildMin[axis][i] = 0xFFFF;
+                    node.ChildMax[axis][i] = 0;
+                    continue;
+                }
+
+                // Round outwards, then correct for float error so the box stays conservative
+                f32 qMin = std::floor((childBounds[i].Min[axis] - origin) / scale);
+                f32 qMax = std::ceil((childBounds[i].Max[axis] - origin) / scale);
+                qMin = qm::clamp(qMin, 0.0f, QuantizationSteps);
+                qMax = qm::clamp(qMax, 0.0f, QuantizationSteps);
+                while (qMin > 0.0f && origin + qMin * scale > childBounds[i].Min[axis]) {
+                    qMin -= 1.0f;
+                }
+                while (qMax < QuantizationSteps &&
+                       origin + qMax * scale < childBounds[i].Max[axis]) {
+                    qMax += 1.0f;
+                }
+
+                node.ChildMin[axis][i] = static_cast<u16>(qMin);
+                node.ChildMax[axis][i] = static_cast<u16>(qMax);
+            }
+        }
+
+        for (u32 i = 0; i < 4; ++i) {
+            node.Child[i] = child[i];
+            node.Count[i] = childCount[i];
+        }
+
+        return nodeIndex;
+    }
+
+    template <typename IntersectFn>
+    bool traverse(const vec3<f32> &origin, const vec3<f32> &direction, f32 inflate,
+                  f32 maxDistance, TriangleHit &hit, IntersectFn &&intersect) const
+    {
+        if (m_nodes.empty()) {
+            return false;
+        }
+
+        const vec3<f32> invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+        struct StackEntry {
+            u32 Node;
+            f32 Distance;
+        };
+        StackEntry stack[StackSize];
+        u32 stackSize = 0;
+        stack[stackSize++] = {0, 0.0f};
+
+        bool found = false;
+        f32 closest = maxDistance;
+
+        while (stackSize > 0) {
+            const StackEntry entry = stack[--stackSize];
+            if (entry.Distance > closest) {
+                continue;
+            }
+
+            const Node &node = m_nodes[entry.Node];
+
+            // Dequantize and slab-test all four children at once; the child-major layout keeps
+            // these loops free of branches so they vectorize
+            f32 tEnter[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            f32 tExit[4] = {closest, closest, closest, closest};
+            for (u32 axis = 0; axis < 3; ++axis) {
+                const f32 base = node.Origin[axis] - origin[axis];
+                const f32 scale = node.Scale[axis];
+                const f32 inv = invDirection[axis];
+                for (u32 i = 0; i < 4; ++i) {
+                    const f32 tA = (base + node.ChildMin[axis][i] * scale - inflate) * inv;
+                    const f32 tB = (base + node.ChildMax[axis][i] * scale + inflate) * inv;
+                    tEnter[i] = qm::max(tEnter[i], qm::min(tA, tB));
+                    tExit[i] = qm::min(tExit[i], qm::max(tA, tB));
+                }
+            }
+
+            u32 order[4];
+            f32 distances[4];
+            u32 hits = 0;
+            for (u32 i = 0; i < 4; ++i) {
+                if (node.Count[i] == EmptySlot || tEnter[i] > tExit[i]) {
+                    continue;
+                }
+
+                // Insertion sort, nearest first
+                u32 slot = hits++;
+                while (slot > 0 && distances[slot - 1] > tEnter[i]) {
+                    distances[slot] = distances[slot - 1];
+                    order[slot] = order[slot - 1];
+                    --slot;
+                }
+                distances[slot] = tEnter[i];
+                order[slot] = i;
+            }
+
+            // Leaves are tested immediately so the closest distance shrinks as early as possible
+            for (u32 k = 0; k < hits; ++k) {
+                const u32 i = order[k];
+                if (node.Count[i] == 0 || distances[k] > closest) {
+                    continue;
+                }
+
+                const u32 end = node.Child[i] + node.Count[i];
+                for (u32 p = node.Child[i]; p < end; ++p) {
+                    f32 t, u, v;
+                    if (intersect(m_triangles[p], t, u, v) && t <= closest) {
+                        closest = t;
+                        hit = {t, u, v, m_triangles[p]};
+                        found = true;
+                    }
+                }
+            }
+
+            // Inner children are pushed far to near so the nearest is visited next
+            for (u32 k = hits; k-- > 0;) {
+                const u32 i = order[k];
+                if (node.Count[i] == 0 && distances[k] <= closest) {
+                    QM_ASSERT(stackSize < StackSize);
+                    stack[stackSize++] = {node.Child[i], distances[k]};
+                }
+            }
+        }
+
+        return found;
+    }
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<u32> m_triangles;
+    std::span<const vec3<f32>> m_vertices;
+    std::span<const u32> m_indices;
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_BVH_HPP
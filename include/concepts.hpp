@@ -21,12 +21,25 @@ concept IsFloatingPointT = std::numeric_limits<T>::is_iec559;
 template <typename T>
 concept IsIntegerT = std::is_integral_v<T>;
 
+// Template meta-variable that number types other than the built-in ones (such as qm::fixed)
+// specialize to true to satisfy IsNumberT
+template <typename T>
+constexpr bool IsCustomNumberT = false;
+
+/**
+ * @brief Concept that checks if a type is an integer, floating-point or custom number type.
+ * @tparam T The type to check.
+ */
+template <typename T>
+concept IsNumberT = std::is_arithmetic_v<T> || IsCustomNumberT<T>;
+
 /**
- * @brief Concept that checks if a type is an integer or floating-point type.
+ * @brief Concept that checks if a type can be used as a radix sort key.
  * @tparam T The type to check.
  */
 template <typename T>
-concept IsNumberT = std::is_arithmetic_v<T>;
+concept IsRadixKeyT = std::is_same_v<T, u32> || std::is_same_v<T, u64> ||
+                      std::is_same_v<T, f32> || std::is_same_v<T, f64>;
 
 /**
  * @brief Concept that checks if a type is a floating-point vector of a specific size.
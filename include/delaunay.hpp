@@ -0,0 +1,656 @@
+#ifndef QUIKMAFF_DELAUNAY_HPP
+#define QUIKMAFF_DELAUNAY_HPP
+
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "functions.hpp"
+#include "morton.hpp"
+#include "predicates.hpp"
+#include "vec2.hpp"
+
+namespace qm {
+
+/**
+ * @brief Delaunay triangulation of a 2D point set.
+ *
+ * Uses the sweep-hull algorithm: starting from a seed triangle near the centre of the points,
+ * points are added in order of distance from the seed, each one outside the current convex
+ * hull. New triangles are fanned from the visible hull edges and made Delaunay with Lawson
+ * edge flips. All orientation and in-circle decisions use the exact predicates, so degenerate
+ * and near-degenerate input triangulates correctly. Duplicate points are skipped.
+ *
+ * The points are first reordered along a Hilbert curve so that spatially close points sit
+ * close together in memory while the hull is swept. The result is a half-edge structure: the
+ * triangles array holds three point indices per counter-clockwise triangle, and the halfedges
+ * array holds, for each edge i (from triangles[i] to the next vertex of its triangle), the
+ * index of the opposite half-edge in the neighbouring triangle, or None on the convex hull.
+ *
+ * @tparam T The floating-point type of the points.
+ *
+ * Example usage:
+ * @code
+ * qm::Delaunay<f32> delaunay;
+ * delaunay.build(points);
+ *
+ * std::span<const u32> triangles = delaunay.triangles();
+ * for (std::size_t i = 0; i < triangles.size(); i += 3) {
+ *     drawTriangle(points[triangles[i]], points[triangles[i + 1]], points[triangles[i + 2]]);
+ * }
+ * @endcode
+ */
+template <IsFloatingPointT T>
+class Delaunay {
+public:
+    static constexpr u32 None = 0xFFFFFFFFu;
+
+    /**
+     * @brief Triangulates a point set.
+     * @param points The points to triangulate.
+     * @return False, with no triangles, if there are fewer than three distinct points or they
+     * are all collinear.
+     */
+    bool build(std::span<const vec2<T>> points)
+    {
+        m_triangles.clear();
+        m_halfedges.clear();
+        m_hull.clear();
+
+        const u32 count = static_cast<u32>(points.size());
+        if (count < 3) {
+            return false;
+        }
+
+        sortPoints(points);
+        if (!createSeed()) {
+            return false;
+        }
+
+        const std::size_t maxTriangles = 2 * static_cast<std::size_t>(count) - 5;
+        m_triangles.reserve(3 * maxTriangles);
+        m_halfedges.reserve(3 * maxTriangles);
+
+        sortByDistance();
+        sweep();
+
+        // Map sorted positions back to the caller's indices
+        for (u32 &vertex : m_triangles) {
+            vertex = m_order[vertex];
+        }
+        u32 e = m_hullStart;
+        do {
+            m_hull.push_back(m_order[e]);
+            e = m_hullNext[e];
+        } while (e != m_hullStart);
+        return true;
+    }
+
+    /**
+     * @brief Returns three point indices per triangle, in counter-clockwise order.
+     */
+    std::span<const u32> triangles() const { return m_triangles; }
+
+    /**
+     * @brief Returns the opposite half-edge of each half-edge, or None on the convex hull.
+     */
+    std::span<const u32> halfedges() const { return m_halfedges; }
+
+    /**
+     * @brief Returns the point indices of the convex hull, in counter-clockwise order.
+     */
+    std::span<const u32> hull() const { return m_hull; }
+
+    /**
+     * @brief Returns the number of triangles.
+     */
+    std::size_t triangleCount() const { return m_triangles.size() / 3; }
+
+    /**
+     * @brief Returns the half-edge following e within its triangle.
+     */
+    static constexpr u32 nextHalfedge(u32 e) { return e % 3 == 2 ? e - 2 : e + 1; }
+
+    /**
+     * @brief Returns the half-edge preceding e within its triangle.
+     */
+    static constexpr u32 prevHalfedge(u32 e) { return e % 3 == 0 ? e + 2 : e - 1; }
+
+private:
+    f64 x(u32 i) const { return m_coords[2 * i]; }
+    f64 y(u32 i) const { return m_coords[2 * i + 1]; }
+
+    f64 orient(u32 a, u32 b, u32 c) const { return orient2d(x(a), y(a), x(b), y(b), x(c), y(c)); }
+
+    // Squared circumradius of a triangle, infinite when it is degenerate.
+    f64 circumradiusSquared(u32 a, u32 b, u32 c) const
+    {
+        const f64 dx = x(b) - x(a);
+        const f64 dy = y(b) - y(a);
+        const f64 ex = x(c) - x(a);
+        const f64 ey = y(c) - y(a);
+        const f64 denominator = dx * ey - dy * ex;
+        if (denominator == 0.0) {
+            return std::numeric_limits<f64>::infinity();
+        }
+
+        const f64 bl = dx * dx + dy * dy;
+        const f64 cl = ex * ex + ey * ey;
+        const f64 d = 0.5 / denominator;
+        const f64 cx = (ey * bl - dy * cl) * d;
+        const f64 cy = (dx * cl - ex * bl) * d;
+        return cx * cx + cy * cy;
+    }
+
+    void circumcenter(u32 a, u32 b, u32 c, f64 &cx, f64 &cy) const
+    {
+        const f64 dx = x(b) - x(a);
+        const f64 dy = y(b) - y(a);
+        const f64 ex = x(c) - x(a);
+        const f64 ey = y(c) - y(a);
+        const f64 bl = dx * dx + dy * dy;
+        const f64 cl = ex * ex + ey * ey;
+        const f64 d = 0.5 / (dx * ey - dy * ex);
+        cx = x(a) + (ey * bl - dy * cl) * d;
+        cy = y(a) + (dx * cl - ex * bl) * d;
+    }
+
+    // Copies the points to double precision, reordered along a Hilbert curve.
+    void sortPoints(std::span<const vec2<T>> points)
+    {
+        const u32 count = static_cast<u32>(points.size());
+
+        f64 minX = std::numeric_limits<f64>::max();
+        f64 minY = std::numeric_limits<f64>::max();
+        f64 maxX = std::numeric_limits<f64>::lowest();
+        f64 maxY = std::numeric_limits<f64>::lowest();
+        for (const vec2<T> &p : points) {
+            minX = qm::min(minX, static_cast<f64>(p.x));
+            minY = qm::min(minY, static_cast<f64>(p.y));
+            maxX = qm::max(maxX, static_cast<f64>(p.x));
+            maxY = qm::max(maxY, static_cast<f64>(p.y));
+        }
+        m_centerX = 0.5 * (minX + maxX);
+        m_centerY = 0.5 * (minY + maxY);
+
+        // Quantize onto a 2^32 grid; 2^32 - 2^11 keeps the rounded product below 2^32
+        const f64 extent = qm::max(maxX - minX, maxY - minY);
+        const f64 scale = extent > 0.0 ? 4294965248.0 / extent : 0.0;
+
+        m_keys.resize(count);
+        m_keyScratch.resize(count);
+        m_order.resize(count);
+        m_indexScratch.resize(count);
+        for (u32 i = 0; i < count; ++i) {
+            const vec2<u32> cell(static_cast<u32>((static_cast<f64>(points[i].x) - minX) * scale),
+                                 static_cast<u32>((static_cast<f64>(points[i].y) - minY) * scale));
+            m_keys[i] = hilbertEncode(cell);
+            m_order[i] = i;
+        }
+        radixSort(std::span<u64>(m_keys), std::span<u32>(m_order), std::span<u64>(m_keyScratch),
+                  std::span<u32>(m_indexScratch));
+
+        m_coords.resize(2 * static_cast<std::size_t>(count));
+        for (u32 i = 0; i < count; ++i) {
+            m_coords[2 * i] = static_cast<f64>(points[m_order[i]].x);
+            m_coords[2 * i + 1] = static_cast<f64>(points[m_order[i]].y);
+        }
+    }
+
+    // Picks a seed triangle with a small circumcircle near the centre of the points.
+    bool createSeed()
+    {
+        const u32 count = static_cast<u32>(m_order.size());
+        auto distanceSquared = [this](u32 i, f64 px, f64 py) {
+            const f64 dx = x(i) - px;
+            const f64 dy = y(i) - py;
+            return dx * dx + dy * dy;
+        };
+
+        f64 best = std::numeric_limits<f64>::infinity();
+        for (u32 i = 0; i < count; ++i) {
+            const f64 d = distanceSquared(i, m_centerX, m_centerY);
+            if (d < best) {
+                best = d;
+                m_seed[0] = i;
+            }
+        }
+
+        best = std::numeric_limits<f64>::infinity();
+        for (u32 i = 0; i < count; ++i) {
+            const f64 d = distanceSquared(i, x(m_seed[0]), y(m_seed[0]));
+            if (d > 0.0 && d < best) {
+                best = d;
+                m_seed[1] = i;
+            }
+        }
+        if (best == std::numeric_limits<f64>::infinity()) {
+            return false;
+        }
+
+        best = std::numeric_limits<f64>::infinity();
+        for (u32 i = 0; i < count; ++i) {
+            if (i == m_seed[0] || i == m_seed[1]) {
+                continue;
+            }
+            const f64 r = circumradiusSquared(m_seed[0], m_seed[1], i);
+            if (r < best) {
+                best = r;
+                m_seed[2] = i;
+            }
+        }
+        if (best == std::numeric_limits<f64>::infinity()) {
+            return false;
+        }
+
+        if (orient(m_seed[0], m_seed[1], m_seed[2]) < 0.0) {
+            std::swap(m_seed[1], m_seed[2]);
+        }
+        circumcenter(m_seed[0], m_seed[1], m_seed[2], m_centerX, m_centerY);
+        return true;
+    }
+
+    // Orders the points by distance from the seed circumcentre, so that each point added lies
+    // outside the hull of the points before it.
+    void sortByDistance()
+    {
+        const u32 count = static_cast<u32>(m_order.size());
+        m_distances.resize(count);
+        m_distanceScratch.resize(count);
+        m_ids.resize(count);
+        for (u32 i = 0; i < count; ++i) {
+            const f64 dx = x(i) - m_centerX;
+            const f64 dy = y(i) - m_centerY;
+            m_distances[i] = dx * dx + dy * dy;
+            m_ids[i] = i;
+        }
+        radixSort(std::span<f64>(m_distances), std::span<u32>(m_ids),
+                  std::span<f64>(m_distanceScratch), std::span<u32>(m_indexScratch));
+    }
+
+    u32 hashKey(f64 px, f64 py) const
+    {
+        // Pseudo-angle around the seed circumcentre, monotonic in the true angle
+        const f64 dx = px - m_centerX;
+        const f64 dy = py - m_centerY;
+        const f64 manhattan = std::abs(dx) + std::abs(dy);
+        if (manhattan == 0.0) {
+            return 0;
+        }
+        const f64 p = dx / manhattan;
+        const f64 angle = (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+        const u32 size = static_cast<u32>(m_hullHash.size());
+        return static_cast<u32>(std::floor(angle * size)) % size;
+    }
+
+    u32 addTriangle(u32 a, u32 b, u32 c, u32 ab, u32 bc, u32 ca)
+    {
+        const u32 t = static_cast<u32>(m_triangles.size());
+        m_triangles.push_back(a);
+        m_triangles.push_back(b);
+        m_triangles.push_back(c);
+        m_halfedges.push_back(None);
+        m_halfedges.push_back(None);
+        m_halfedges.push_back(None);
+        link(t, ab);
+        link(t + 1, bc);
+        link(t + 2, ca);
+        return t;
+    }
+
+    void link(u32 a, u32 b)
+    {
+        m_halfedges[a] = b;
+        if (b != None) {
+            m_halfedges[b] = a;
+        }
+    }
+
+    void sweep()
+    {
+        const u32 count = static_cast<u32>(m_order.size());
+        const u32 i0 = m_seed[0];
+        const u32 i1 = m_seed[1];
+        const u32 i2 = m_seed[2];
+
+        m_hullPrev.assign(count, 0);
+        m_hullNext.assign(count, 0);
+        m_hullTri.assign(count, 0);
+        m_hullHash.assign(static_cast<std::size_t>(std::ceil(std::sqrt(f64(count)))), None);
+
+        // The hull is a counter-clockwise ring; m_hullTri[v] is the half-edge leaving v along it
+        m_hullStart = i0;
+        m_hullNext[i0] = m_hullPrev[i2] = i1;
+        m_hullNext[i1] = m_hullPrev[i0] = i2;
+        m_hullNext[i2] = m_hullPrev[i1] = i0;
+        m_hullTri[i0] = 0;
+        m_hullTri[i1] = 1;
+        m_hullTri[i2] = 2;
+        m_hullHash[hashKey(x(i0), y(i0))] = i0;
+        m_hullHash[hashKey(x(i1), y(i1))] = i1;
+        m_hullHash[hashKey(x(i2), y(i2))] = i2;
+
+        addTriangle(i0, i1, i2, None, None, None);
+
+        f64 previousX = 0.0;
+        f64 previousY = 0.0;
+        for (u32 k = 0; k < count; ++k) {
+            const u32 i = m_ids[k];
+            const f64 px = x(i);
+            const f64 py = y(i);
+
+            // Skip duplicates and the seed
+            if (k > 0 && px == previousX && py == previousY) {
+                continue;
+            }
+            previousX = px;
+            previousY = py;
+            if (i == i0 || i == i1 || i == i2) {
+                continue;
+            }
+
+            // Find a hull edge visible from the point, starting near it in angle
+            u32 start = 0;
+            const u32 key = hashKey(px, py);
+            for (u32 j = 0; j < m_hullHash.size(); ++j) {
+                start = m_hullHash[(key + j) % m_hullHash.size()];
+                if (start != None && start != m_hullNext[start]) {
+                    break;
+                }
+            }
+
+            start = m_hullPrev[start];
+            u32 e = start;
+            u32 q = m_hullNext[e];
+            while (orient(e, q, i) >= 0.0) {
+                e = q;
+                if (e == start) {
+                    e = None;
+                    break;
+                }
+                q = m_hullNext[e];
+            }
+            if (e == None) {
+                continue; // Coincides with an existing point
+            }
+
+            // Fan the first triangle from the visible edge
+            u32 t = addTriangle(e, i, m_hullNext[e], None, None, m_hullTri[e]);
+            m_hullTri[e] = t;
+            m_hullTri[i] = t + 1;
+            legalize(t + 2);
+
+            // Walk forward along the hull, adding triangles while edges stay visible
+            u32 n = m_hullNext[e];
+            q = m_hullNext[n];
+            while (orient(n, q, i) < 0.0) {
+                t = addTriangle(n, i, q, m_hullTri[i], None, m_hullTri[n]);
+                m_hullTri[i] = t + 1;
+                legalize(t + 2);
+                m_hullNext[n] = n; // Mark as removed from the hull
+                n = q;
+                q = m_hullNext[n];
+            }
+
+            // Walk backward from the other side
+            if (e == start) {
+                q = m_hullPrev[e];
+                while (orient(q, e, i) < 0.0) {
+                    t = addTriangle(q, i, e, None, m_hullTri[e], m_hullTri[q]);
+                    m_hullTri[q] = t;
+                    legalize(t + 2);
+                    m_hullNext[e] = e;
+                    e = q;
+                    q = m_hullPrev[e];
+                }
+            }
+
+            m_hullStart = m_hullPrev[i] = e;
+            m_hullNext[e] = m_hullPrev[n] = i;
+            m_hullNext[i] = n;
+
+            m_hullHash[hashKey(px, py)] = i;
+            m_hullHash[hashKey(x(e), y(e))] = e;
+        }
+    }
+
+    // Flips edges until the triangles around half-edge a satisfy the Delaunay condition.
+    void legalize(u32 a)
+    {
+        m_edgeStack.clear();
+        while (true) {
+            const u32 b = m_halfedges[a];
+
+            /* Triangles (pr, pl, p0) and (pl, pr, p1) share the edge a = pr -> pl. If p1 lies
+             * inside the circumcircle of the first, replace the shared edge with p0 -> p1:
+             *
+             *           pl                    pl
+             *          /||\                  /  \
+             *       al/ || \bl            al/    \a
+             *        /  ||  \              /      \
+             *       /  a||b  \    flip    /___ar___\
+             *     p0\   ||   /p1   =>   p0\---bl---/p1
+             *        \  ||  /              \      /
+             *       ar\ || /br             b\    /br
+             *          \||/                  \  /
+             *           pr                    pr
+             */
+            if (b == None) {
+                if (m_edgeStack.empty()) {
+                    return;
+                }
+                a = m_edgeStack.back();
+                m_edgeStack.pop_back();
+                continue;
+            }
+
+            const u32 a0 = a - a % 3;
+            const u32 b0 = b - b % 3;
+            const u32 al = a0 + (a + 1) % 3;
+            const u32 ar = a0 + (a + 2) % 3;
+            const u32 bl = b0 + (b + 2) % 3;
+            const u32 br = b0 + (b + 1) % 3;
+
+            const u32 p0 = m_triangles[ar];
+            const u32 pr = m_triangles[a];
+            const u32 pl = m_triangles[al];
+            const u32 p1 = m_triangles[bl];
+
+            if (incircle(x(pr), y(pr), x(pl), y(pl), x(p0), y(p0), x(p1), y(p1)) > 0.0) {
+                m_triangles[a] = p1;
+                m_triangles[b] = p0;
+
+                // Hull edges keep their start vertex but move to another half-edge
+                const u32 hbl = m_halfedges[bl];
+                const u32 har = m_halfedges[ar];
+                if (hbl == None) {
+                    m_hullTri[p1] = a;
+                }
+                if (har == None) {
+                    m_hullTri[p0] = b;
+                }
+
+                link(a, hbl);
+                link(b, har);
+                link(ar, bl);
+                m_edgeStack.push_back(br);
+            }
+            else {
+                if (m_edgeStack.empty()) {
+                    return;
+                }
+                a = m_edgeStack.back();
+                m_edgeStack.pop_back();
+            }
+        }
+    }
+
+private:
+    std::vector<u32> m_triangles;
+    std::vector<u32> m_halfedges;
+    std::vector<u32> m_hull;
+
+    // Build state, kept so repeated builds reuse the allocations
+    std::vector<f64> m_coords;
+    std::vector<u64> m_keys;
+    std::vector<u64> m_keyScratch;
+    std::vector<u32> m_order;
+    std::vector<u32> m_indexScratch;
+    std::vector<f64> m_distances;
+    std::vector<f64> m_distanceScratch;
+    std::vector<u32> m_ids;
+    std::vector<u32> m_hullPrev;
+    std::vector<u32> m_hullNext;
+    std::vector<u32> m_hullTri;
+    std::vector<u32> m_hullHash;
+    std::vector<u32> m_edgeStack;
+    u32 m_hullStart = 0;
+    u32 m_seed[3] = {0, 0, 0};
+    f64 m_centerX = 0.0;
+    f64 m_centerY = 0.0;
+};
+
+/**
+ * @brief Voronoi diagram of a 2D point set, extracted as the dual of its Delaunay triangulation.
+ *
+ * The vertices of the diagram are the circumcentres of the Delaunay triangles, and the cell
+ * of a point is the ring of circumcentres of the triangles around it. Cells of points on the
+ * convex hull are unbounded; their first and last vertices are where the two infinite edges
+ * start, running perpendicular to the adjacent hull edges.
+ *
+ * @tparam T The floating-point type of the points.
+ *
+ * Example usage:
+ * @code
+ * qm::Voronoi<f32> voronoi;
+ * voronoi.build(delaunay, points);
+ *
+ * std::array<vec2<f32>, 32> cell;
+ * std::size_t vertices = voronoi.cell(site, cell);
+ * @endcode
+ */
+template <IsFloatingPointT T>
+class Voronoi {
+public:
+    /**
+     * @brief Computes the circumcentres and cell adjacency from a triangulation.
+     *
+     * The diagram refers to the triangulation's half-edges, so the triangulation must outlive
+     * it and not be rebuilt in between.
+     *
+     * @param delaunay A triangulation built from points.
+     * @param points The points the triangulation was built from.
+     */
+    void build(const Delaunay<T> &delaunay, std::span<const vec2<T>> points)
+    {
+        const std::span<const u32> triangles = delaunay.triangles();
+        const std::span<const u32> halfedges = delaunay.halfedges();
+        m_halfedges = halfedges;
+
+        m_circumcenters.resize(triangles.size() / 3);
+        for (std::size_t t = 0; t < m_circumcenters.size(); ++t) {
+            const vec2<T> &a = points[triangles[3 * t]];
+            const vec2<T> &b = points[triangles[3 * t + 1]];
+            const vec2<T> &c = points[triangles[3 * t + 2]];
+            const f64 dx = static_cast<f64>(b.x) - static_cast<f64>(a.x);
+            const f64 dy = static_cast<f64>(b.y) - static_cast<f64>(a.y);
+            const f64 ex = static_cast<f64>(c.x) - static_cast<f64>(a.x);
+            const f64 ey = static_cast<f64>(c.y) - static_cast<f64>(a.y);
+            const f64 bl = dx * dx + dy * dy;
+            const f64 cl = ex * ex + ey * ey;
+            const f64 d = 0.5 / (dx * ey - dy * ex);
+            m_circumcenters[t] =
+                vec2<T>(static_cast<T>(static_cast<f64>(a.x) + (ey * bl - dy * cl) * d),
+                        static_cast<T>(static_cast<f64>(a.y) + (dx * cl - ex * bl) * d));
+        }
+
+        // One outgoing half-edge per point, preferring hull edges so cell walks cover every
+        // triangle around hull points
+        m_outedges.assign(points.size(), Delaunay<T>::None);
+        for (u32 e = 0; e < triangles.size(); ++e) {
+            const u32 point = triangles[e];
+            if (halfedges[e] == Delaunay<T>::None || m_outedges[point] == Delaunay<T>::None) {
+                m_outedges[point] = e;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the circumcentre of each Delaunay triangle.
+     */
+    std::span<const vec2<T>> circumcenters() const { return m_circumcenters; }
+
+    /**
+     * @brief Returns the cell of a point as the indices of its vertices in circumcenters().
+     * @param point Index of the point.
+     * @param out Receives the vertex indices in counter-clockwise order; vertices beyond its
+     * size are counted but not written.
+     * @return The number of vertices in the cell, 0 for skipped duplicate points.
+     */
+    std::size_t cell(u32 point, std::span<u32> out) const
+    {
+        const u32 start = m_outedges[point];
+        if (start == Delaunay<T>::None) {
+            return 0;
+        }
+
+        // Walk the triangles around the point; for hull points this runs from the outgoing hull
+        // edge to the incoming one
+        std::size_t count = 0;
+        u32 e = start;
+        do {
+            if (count < out.size()) {
+                out[count] = e / 3;
+            }
+            ++count;
+            e = m_halfedges[Delaunay<T>::prevHalfedge(e)];
+        } while (e != start && e != Delaunay<T>::None);
+        return count;
+    }
+
+    /**
+     * @brief Returns the cell of a point as vertex positions.
+     * @param point Index of the point.
+     * @param out Receives the vertices in counter-clockwise order; vertices beyond its size are
+     * counted but not written.
+     * @return The number of vertices in the cell.
+     */
+    std::size_t cell(u32 point, std::span<vec2<T>> out) const
+    {
+        const u32 start = m_outedges[point];
+        if (start == Delaunay<T>::None) {
+            return 0;
+        }
+
+        std::size_t count = 0;
+        u32 e = start;
+        do {
+            if (count < out.size()) {
+                out[count] = m_circumcenters[e / 3];
+            }
+            ++count;
+            e = m_halfedges[Delaunay<T>::prevHalfedge(e)];
+        } while (e != start && e != Delaunay<T>::None);
+        return count;
+    }
+
+    /**
+     * @brief Returns whether the cell of a point is unbounded, which is when the point lies on
+     * the convex hull.
+     */
+    bool isUnbounded(u32 point) const
+    {
+        const u32 e = m_outedges[point];
+        return e != Delaunay<T>::None && m_halfedges[e] == Delaunay<T>::None;
+    }
+
+private:
+    std::span<const u32> m_halfedges;
+    std::vector<vec2<T>> m_circumcenters;
+    std::vector<u32> m_outedges;
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_DELAUNAY_HPP
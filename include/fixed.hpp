@@ -0,0 +1,406 @@
+#ifndef QUIKMAFF_FIXED_HPP
+#define QUIKMAFF_FIXED_HPP
+
+#include <array>
+#include <compare>
+#include <limits>
+#include <type_traits>
+
+#include "concepts.hpp"
+#include "types.hpp"
+
+/**
+ * Binary fixed-point numbers for deterministic simulation.
+ *
+ * Every operation on qm::fixed is integer arithmetic with a fixed rounding rule, so the same
+ * inputs give bit-identical results on every compiler and CPU, which floats cannot promise.
+ * The type satisfies IsNumberT, so vec2<qm::fixed<16, 16>> and friends work for component-wise
+ * arithmetic; sqrt, sin and cos have integer implementations found by ADL.
+ */
+
+namespace qm {
+
+/**
+ * @brief A signed binary fixed-point number with IntBits integer bits (including the sign) and
+ * FracBits fractional bits.
+ *
+ * The value is stored as an integer scaled by 2^FracBits in the narrowest of i16 and i32 that
+ * holds IntBits + FracBits bits; any spare storage bits extend the integer range.
+ * Multiplication and division widen to twice that size, so they are exact before the final
+ * rounding. Overflow wraps, as the underlying integers do.
+ * Conversions to and from built-in types are explicit, so float arithmetic cannot slip into a
+ * deterministic computation unnoticed.
+ *
+ * @tparam IntBits Integer bits including the sign bit.
+ * @tparam FracBits Fractional bits.
+ *
+ * Example usage:
+ * @code
+ * using Fx = qm::fixed<16, 16>;
+ * vec2<Fx> position(Fx(10), Fx(2.5));
+ * vec2<Fx> velocity(Fx(0.25), Fx(-1));
+ * position += velocity * Fx(3);
+ * @endcode
+ */
+template <int IntBits, int FracBits>
+class fixed {
+    static_assert(IntBits >= 1 && FracBits >= 0 && IntBits + FracBits <= 32,
+                  "fixed supports up to 32 bits including the sign bit");
+
+public:
+    using Storage = std::conditional_t<(IntBits + FracBits <= 16), i16, i32>;
+    using Wide = std::conditional_t<(IntBits + FracBits <= 16), i32, i64>;
+
+    static constexpr int IntegerBits = IntBits;
+    static constexpr int FractionBits = FracBits;
+    static constexpr Wide One = Wide{1} << FracBits;
+
+    constexpr fixed() = default;
+
+    /**
+     * @brief Converts an integer exactly, wrapping if it is out of range.
+     */
+    template <IsIntegerT A>
+    explicit constexpr fixed(A value) : m_raw{static_cast<Storage>(static_cast<Wide>(value) * One)}
+    {
+    }
+
+    /**
+     * @brief Converts a floating-point value, rounding to the nearest representable value.
+     */
+    template <IsFloatingPointT A>
+    explicit constexpr fixed(A value)
+        : m_raw{static_cast<Storage>(static_cast<Wide>(value * static_cast<A>(One) +
+                                                       static_cast<A>(value < 0 ? -0.5 : 0.5)))}
+    {
+    }
+
+    /**
+     * @brief Converts between fixed-point formats, rounding to nearest when bits are dropped.
+     */
+    template <int I, int F>
+    explicit constexpr fixed(fixed<I, F> value)
+        : m_raw{static_cast<Storage>(rescale<F>(value.raw()))}
+    {
+    }
+
+    /**
+     * @brief Returns the value with the given raw scaled integer.
+     */
+    static constexpr fixed fromRaw(Storage raw)
+    {
+        fixed result;
+        result.m_raw = raw;
+        return result;
+    }
+
+    /**
+     * @brief Returns the scaled integer, value * 2^FracBits.
+     */
+    constexpr Storage raw() const { return m_raw; }
+
+    /**
+     * @brief Converts to a floating-point type exactly (for f64) or rounded (for f32).
+     */
+    template <IsFloatingPointT A>
+    explicit constexpr operator A() const
+    {
+        return static_cast<A>(m_raw) / static_cast<A>(One);
+    }
+
+    /**
+     * @brief Converts to an integer, rounding toward negative infinity.
+     */
+    template <IsIntegerT A>
+    explicit constexpr operator A() const
+    {
+        return static_cast<A>(m_raw >> FracBits);
+    }
+
+    // Arithmetic operators
+    constexpr fixed operator+() const { return *this; }
+    constexpr fixed operator-() const
+    {
+        return fromRaw(static_cast<Storage>(-static_cast<Wide>(m_raw)));
+    }
+
+    friend constexpr fixed operator+(fixed a, fixed b)
+    {
+        return fromRaw(static_cast<Storage>(static_cast<Wide>(a.m_raw) + b.m_raw));
+    }
+
+    friend constexpr fixed operator-(fixed a, fixed b)
+    {
+        return fromRaw(static_cast<Storage>(static_cast<Wide>(a.m_raw) - b.m_raw));
+    }
+
+    // The double-width product is rounded to nearest, ties toward positive infinity
+    friend constexpr fixed operator*(fixed a, fixed b)
+    {
+        const Wide product = static_cast<Wide>(a.m_raw) * b.m_raw;
+        return fromRaw(static_cast<Storage>(roundShift(product, FracBits)));
+    }
+
+    // The quotient is truncated toward zero, like integer division
+    friend constexpr fixed operator/(fixed a, fixed b)
+    {
+        QM_ASSERT(b.m_raw != 0);
+        return fromRaw(static_cast<Storage>(static_cast<Wide>(a.m_raw) * One / b.m_raw));
+    }
+
+    friend constexpr fixed operator%(fixed a, fixed b)
+    {
+        QM_ASSERT(b.m_raw != 0);
+        return fromRaw(static_cast<Storage>(a.m_raw % b.m_raw));
+    }
+
+    // Scaling by integers is exact
+    template <IsIntegerT A>
+    friend constexpr fixed operator*(fixed a, A b)
+    {
+        return fromRaw(static_cast<Storage>(static_cast<Wide>(a.m_raw) * b));
+    }
+
+    template <IsIntegerT A>
+    friend constexpr fixed operator*(A a, fixed b)
+    {
+        return b * a;
+    }
+
+    template <IsIntegerT A>
+    friend constexpr fixed operator/(fixed a, A b)
+    {
+        QM_ASSERT(b != 0);
+        return fromRaw(static_cast<Storage>(static_cast<Wide>(a.m_raw) / b));
+    }
+
+    constexpr fixed &operator+=(fixed other) { return *this = *this + other; }
+    constexpr fixed &operator-=(fixed other) { return *this = *this - other; }
+    constexpr fixed &operator*=(fixed other) { return *this = *this * other; }
+    constexpr fixed &operator/=(fixed other) { return *this = *this / other; }
+    constexpr fixed &operator%=(fixed other) { return *this = *this % other; }
+
+    // Increment and decrement step by one whole unit
+    constexpr fixed &operator++() { return *this += fixed(1); }
+    constexpr fixed &operator--() { return *this -= fixed(1); }
+
+    constexpr fixed operator++(int)
+    {
+        const fixed result = *this;
+        ++*this;
+        return result;
+    }
+
+    constexpr fixed operator--(int)
+    {
+        const fixed result = *this;
+        --*this;
+        return result;
+    }
+
+    // Comparison operators
+    constexpr auto operator<=>(const fixed &) const = default;
+    constexpr bool operator==(const fixed &) const = default;
+
+private:
+    template <int IntBits2, int FracBits2>
+    friend class fixed;
+
+    static constexpr Wide roundShift(Wide value, int bits)
+    {
+        return bits == 0 ? value : (value + (Wide{1} << (bits - 1))) >> bits;
+    }
+
+    template <int FromFracBits, typename R>
+    static constexpr i64 rescale(R raw)
+    {
+        if constexpr (FromFracBits >= FracBits) {
+            constexpr int drop = FromFracBits - FracBits;
+            if constexpr (drop == 0) {
+                return static_cast<i64>(raw);
+            }
+            else {
+                return (static_cast<i64>(raw) + (i64{1} << (drop - 1))) >> drop;
+            }
+        }
+        else {
+            return static_cast<i64>(raw) * (i64{1} << (FracBits - FromFracBits));
+        }
+    }
+
+    Storage m_raw = 0;
+};
+
+namespace detail {
+
+// sin(x) on [0, pi/2] from its Taylor series, for building tables at compile time.
+constexpr f64 taylorSin(f64 x)
+{
+    f64 term = x;
+    f64 sum = x;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x * x / static_cast<f64>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+// A quarter wave of sine in Q1.30 at 256 steps, with a repeated last entry so interpolation at
+// exactly a quarter turn reads in bounds.
+inline constexpr std::array<i32, 258> QuarterSineTable = [] {
+    std::array<i32, 258> table{};
+    for (int i = 0; i <= 256; ++i) {
+        const f64 angle = 1.5707963267948966 * i / 256.0;
+        table[i] = static_cast<i32>(taylorSin(angle) * 1073741824.0 + 0.5);
+    }
+    table[257] = table[256];
+    return table;
+}();
+
+// Sine of turn / 2^32 of a full turn in Q1.30, linearly interpolated from the quarter table.
+constexpr i32 sinTurnQ30(u32 turn)
+{
+    const u32 quadrant = turn >> 30;
+    u32 position = turn & 0x3FFF'FFFFu;
+    if (quadrant & 1u) {
+        position = 0x4000'0000u - position;
+    }
+
+    const u32 index = position >> 22;
+    const i64 fraction = position & 0x3F'FFFFu;
+    const i64 a = QuarterSineTable[index];
+    const i64 b = QuarterSineTable[index + 1];
+    const i32 value = static_cast<i32>(a + (((b - a) * fraction + (i64{1} << 21)) >> 22));
+    return quadrant & 2u ? -value : value;
+}
+
+// Converts radians in fixed point to a fraction of a turn scaled by 2^32, wrapping.
+template <int I, int F>
+constexpr u32 radiansToTurn(fixed<I, F> radians)
+{
+    constexpr i64 TurnsPerRadian = 683565276; // 2^32 / (2 pi)
+    const i64 scaled = static_cast<i64>(radians.raw()) * TurnsPerRadian;
+    return static_cast<u32>(F == 0 ? scaled : scaled >> F);
+}
+
+template <int I, int F>
+constexpr fixed<I, F> fromQ30(i32 value)
+{
+    static_assert(I >= 2, "fixed needs two integer bits to hold sin and cos");
+    using Storage = typename fixed<I, F>::Storage;
+    if constexpr (F <= 30) {
+        constexpr int drop = 30 - F;
+        return fixed<I, F>::fromRaw(static_cast<Storage>(
+            drop == 0 ? value : (static_cast<i64>(value) + (i64{1} << (drop - 1))) >> drop));
+    }
+    else {
+        return fixed<I, F>::fromRaw(static_cast<Storage>(static_cast<i64>(value) << (F - 30)));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the square root, rounded down to a representable value. Negative inputs give 0.
+ *
+ * Computed digit by digit on the double-width integer, so it is exact and deterministic.
+ */
+template <int I, int F>
+constexpr fixed<I, F> sqrt(fixed<I, F> value)
+{
+    if (value.raw() <= 0) {
+        return fixed<I, F>{};
+    }
+
+    // sqrt(raw / 2^F) * 2^F = sqrt(raw * 2^F)
+    u64 remainder = static_cast<u64>(value.raw()) << F;
+    u64 root = 0;
+    u64 bit = u64{1} << 62;
+    while (bit > remainder) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (remainder >= root + bit) {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return fixed<I, F>::fromRaw(static_cast<typename fixed<I, F>::Storage>(root));
+}
+
+/**
+ * @brief Returns the sine of an angle in radians from a 1024-entry-per-turn table.
+ *
+ * Linear interpolation keeps the error below 5e-6 before rounding to the format.
+ */
+template <int I, int F>
+constexpr fixed<I, F> sin(fixed<I, F> angle)
+{
+    return detail::fromQ30<I, F>(detail::sinTurnQ30(detail::radiansToTurn(angle)));
+}
+
+/**
+ * @brief Returns the cosine of an angle in radians from a 1024-entry-per-turn table.
+ */
+template <int I, int F>
+constexpr fixed<I, F> cos(fixed<I, F> angle)
+{
+    return detail::fromQ30<I, F>(detail::sinTurnQ30(detail::radiansToTurn(angle) + 0x4000'0000u));
+}
+
+/**
+ * @brief Returns the absolute value.
+ */
+template <int I, int F>
+constexpr fixed<I, F> abs(fixed<I, F> value)
+{
+    return value.raw() < 0 ? -value : value;
+}
+
+} // namespace qm
+
+template <int I, int F>
+constexpr bool IsCustomNumberT<qm::fixed<I, F>> = true;
+
+template <int I, int F>
+class std::numeric_limits<qm::fixed<I, F>> {
+    using Fixed = qm::fixed<I, F>;
+    using Storage = typename Fixed::Storage;
+
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = true;
+    static constexpr int radix = 2;
+    static constexpr int digits = std::numeric_limits<Storage>::digits;
+
+    static constexpr Fixed min() { return Fixed::fromRaw(1); }
+    static constexpr Fixed max() { return Fixed::fromRaw(std::numeric_limits<Storage>::max()); }
+    static constexpr Fixed lowest()
+    {
+        return Fixed::fromRaw(std::numeric_limits<Storage>::lowest());
+    }
+    static constexpr Fixed epsilon() { return Fixed::fromRaw(1); }
+    static constexpr Fixed round_error()
+    {
+        return Fixed::fromRaw(static_cast<Storage>(F > 0 ? i64{1} << (F - 1) : 0));
+    }
+};
+
+template <int I, int F>
+struct std::formatter<qm::fixed<I, F>> : std::formatter<double> {
+    auto format(qm::fixed<I, F> value, auto &context) const
+    {
+        return std::formatter<double>::format(static_cast<double>(value), context);
+    }
+};
+
+#endif // QUIKMAFF_FIXED_HPP
@@ -1,7 +1,11 @@
 #ifndef QUIKMAFF_FUNCTIONS_HPP
 #define QUIKMAFF_FUNCTIONS_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <span>
 
 #include "concepts.hpp"
 #include "constants.hpp"
@@ -187,12 +191,39 @@ constexpr T tan(T angle)
 }
 
 template <typename T>
-T abs(T value)
+constexpr T abs(T value)
 {
-    //const int y = x >> (sizeof(int) * 8 - 1);
-    //return (x ^ y) - y;
+    return value < static_cast<T>(0) ? -value : value;
 }
 
+/**
+ * @brief Type that square roots, lengths and distances of T are computed in.
+ *
+ * Integer types promote to f64, as std::sqrt does for them; floating-point and custom number
+ * types such as qm::fixed keep their own type, so vec3<f64> never narrows to float.
+ */
+template <IsNumberT T>
+using RealT = std::conditional_t<std::is_integral_v<T>, f64, T>;
+
+/**
+ * @brief Type of the product of an A and a B under the built-in promotions.
+ *
+ * Integers narrower than int multiply as int, so sums of squares of u8 or i16 components do not
+ * wrap back into the component type.
+ */
+template <IsNumberT A, IsNumberT B = A>
+using ProductT = decltype(std::declval<A>() * std::declval<B>());
+
+/**
+ * @brief Component type of a vector of T scaled by a scalar of type S.
+ *
+ * Integer vectors promote to the common type, as the built-in operators do, so vec2i * 0.5f is a
+ * vec2<f32>. Floating-point and custom vectors keep T, so vec3f * 0.5 stays a vec3f.
+ */
+template <IsNumberT T, IsNumberT S>
+using ScaledT = typename std::conditional_t<std::is_integral_v<T>, std::common_type<T, S>,
+                                            std::type_identity<T>>::type;
+
 /**
  * @brief Calculate the square root of a numeric type.
  *
@@ -390,7 +421,7 @@ constexpr T percentage(T value, T total)
  * This function performs linear interpolation between two values based on an interpolation
  * parameter 't'.
  *
- * @tparam ValueType The type of values to interpolate.
+ * @tparam ValueType The type of values to interpolate; scalars and vectors both work.
  * @tparam InterpolationType The type of the interpolation parameter.
  * @param startValue The starting value for interpolation.
  * @param endValue The ending value for interpolation.
@@ -408,7 +439,7 @@ constexpr ValueType lerp(const ValueType &startValue, const ValueType &endValue,
                          InterpolationType t)
 {
     t = clamp(t, static_cast<InterpolationType>(0), static_cast<InterpolationType>(1));
-    return startValue * (static_cast<ValueType>(1) - t) + endValue * t;
+    return startValue * (static_cast<InterpolationType>(1) - t) + endValue * t;
 }
 
 /**
@@ -504,7 +535,7 @@ constexpr bool compare(const T x, const T y)
  * @param x2 The x-coordinate of the second point.
  * @param y2 The y-coordinate of the second point.
  * @param z2 The z-coordinate of the second point.
- * @return The distance between the two points.
+ * @return The distance between the two points, as f64 for integer coordinates and T otherwise.
  *
  * Example:
  * ```
@@ -512,16 +543,174 @@ constexpr bool compare(const T x, const T y)
  * // distance is approximately 5.1962, which is the Euclidean distance between the two points.
  * ```
  */
-template <typename T>
-constexpr f32 distance(T x1, T y1, T z1, T x2, T y2, T z2)
+template <IsNumberT T>
+constexpr RealT<T> distance(T x1, T y1, T z1, T x2, T y2, T z2)
 {
-    T dx = x2 - x1;
-    T dy = y2 - y1;
-    T dz = z2 - z1;
+    const RealT<T> dx = static_cast<RealT<T>>(x2) - static_cast<RealT<T>>(x1);
+    const RealT<T> dy = static_cast<RealT<T>>(y2) - static_cast<RealT<T>>(y1);
+    const RealT<T> dz = static_cast<RealT<T>>(z2) - static_cast<RealT<T>>(z1);
 
     return sqrt(dx * dx + dy * dy + dz * dz);
 }
 
+namespace detail {
+
+// Maps the top 24 bits of a random word or 0.32 fixed-point fraction to [0, 1). Every result is
+// exact in f32, so generators and sequences that share a word give the same float.
+constexpr f32 unitFloat(u32 word) { return static_cast<f32>(word >> 8) * 0x1p-24f; }
+
+/**
+ * @brief Maps radix sort keys to unsigned integers with the same ordering.
+ */
+template <IsRadixKeyT K>
+struct RadixKey {
+    using Bits = K;
+    static constexpr Bits toBits(K key) { return key; }
+};
+
+// Floats flip all bits of negatives and only the sign bit of positives, so that the unsigned
+// order matches the numeric one (-0.0 sorts before +0.0, NaNs sort to the ends).
+template <>
+struct RadixKey<f32> {
+    using Bits = u32;
+    static constexpr Bits toBits(f32 key)
+    {
+        const Bits bits = std::bit_cast<Bits>(key);
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+};
+
+template <>
+struct RadixKey<f64> {
+    using Bits = u64;
+    static constexpr Bits toBits(f64 key)
+    {
+        const Bits bits = std::bit_cast<Bits>(key);
+        return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+    }
+};
+
+constexpr u32 RadixDigitBits = 8;
+constexpr u32 RadixBuckets = 1u << RadixDigitBits;
+
+template <typename K>
+constexpr u32 radixDigit(K key, u32 pass)
+{
+    return static_cast<u32>((RadixKey<K>::toBits(key) >> (pass * RadixDigitBits)) &
+                            (RadixBuckets - 1));
+}
+
+// Least significant digit first, 8 bits per pass. Values are moved along with their keys only
+// when HasValues is set, so the keys-only sort has no per-element branch. Passes in which every
+// key shares the same digit are skipped.
+template <bool HasValues, IsRadixKeyT K, typename V>
+void radixSortImpl(K *keys, K *keyScratch, V *values, V *valueScratch, std::size_t count)
+{
+    constexpr u32 passes = sizeof(K);
+
+    std::array<std::array<std::size_t, RadixBuckets>, passes> histograms{};
+    for (std::size_t i = 0; i < count; ++i) {
+        for (u32 pass = 0; pass < passes; ++pass) {
+            ++histograms[pass][radixDigit(keys[i], pass)];
+        }
+    }
+
+    K *srcKeys = keys;
+    K *dstKeys = keyScratch;
+    V *srcValues = values;
+    V *dstValues = valueScratch;
+
+    for (u32 pass = 0; pass < passes; ++pass) {
+        std::array<std::size_t, RadixBuckets> &offsets = histograms[pass];
+        if (offsets[radixDigit(srcKeys[0], pass)] == count) {
+            continue;
+        }
+
+        std::size_t sum = 0;
+        for (std::size_t &offset : offsets) {
+            const std::size_t bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t target = offsets[radixDigit(srcKeys[i], pass)]++;
+            dstKeys[target] = srcKeys[i];
+            if constexpr (HasValues) {
+                dstValues[target] = srcValues[i];
+            }
+        }
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    if (srcKeys != keys) {
+        std::copy(srcKeys, srcKeys + count, keys);
+        if constexpr (HasValues) {
+            std::copy(srcValues, srcValues + count, values);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Sorts keys in ascending order with an LSD radix sort.
+ *
+ * Supports u32, u64, f32 and f64 keys. Floats are ordered numerically, with -0.0 before +0.0.
+ * No memory is allocated; the caller provides a scratch buffer of at least keys.size() elements.
+ *
+ * @tparam K The key type.
+ * @param keys The keys to sort.
+ * @param scratch Scratch buffer, at least as large as keys.
+ *
+ * Example:
+ * ```
+ * std::vector<f32> depths = ...;
+ * std::vector<f32> scratch(depths.size());
+ * qm::radixSort(std::span<f32>(depths), std::span<f32>(scratch));
+ * ```
+ */
+template <IsRadixKeyT K>
+void radixSort(std::span<K> keys, std::span<K> scratch)
+{
+    QM_ASSERT(scratch.size() >= keys.size());
+    if (keys.size() > 1) {
+        detail::radixSortImpl<false, K, K>(keys.data(), scratch.data(), nullptr, nullptr,
+                                           keys.size());
+    }
+}
+
+/**
+ * @brief Sorts key-value pairs by key in ascending order with a stable LSD radix sort.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type, moved along with its key.
+ * @param keys The keys to sort.
+ * @param values The values, one per key.
+ * @param keyScratch Scratch buffer, at least as large as keys.
+ * @param valueScratch Scratch buffer, at least as large as values.
+ *
+ * Example:
+ * ```
+ * // Sort entity indices by their Morton keys
+ * qm::radixSort(std::span<u64>(keys), std::span<u32>(entities), std::span<u64>(keyScratch),
+ *               std::span<u32>(entityScratch));
+ * ```
+ */
+template <IsRadixKeyT K, typename V>
+void radixSort(std::span<K> keys, std::span<V> values, std::span<K> keyScratch,
+               std::span<V> valueScratch)
+{
+    QM_ASSERT(values.size() >= keys.size());
+    QM_ASSERT(keyScratch.size() >= keys.size() && valueScratch.size() >= keys.size());
+    if (keys.size() > 1) {
+        detail::radixSortImpl<true>(keys.data(), keyScratch.data(), values.data(),
+                                    valueScratch.data(), keys.size());
+    }
+}
+
 } // namespace qm
 
 #endif // QUIKMAFF_FUNCTIONS_HPP
\ No newline at end of file
@@ -0,0 +1,440 @@
+#ifndef QUIKMAFF_HALF_HPP
+#define QUIKMAFF_HALF_HPP
+
+#include <bit>
+#include <span>
+
+#include "vec2.hpp"
+#include "vec3.hpp"
+#include "vec4.hpp"
+
+#if defined(QM_AVX2) || defined(QM_F16C)
+#include <immintrin.h>
+#endif
+
+/**
+ * 16-bit floating-point storage types.
+ *
+ * qm::f16 is IEEE 754 binary16 (5 exponent bits, 10 mantissa bits): about three decimal digits
+ * over +-65504, suited to vertex attributes and colours. qm::bf16 is bfloat16, the top half of
+ * an f32 (8 exponent bits, 7 mantissa bits): the full f32 range at two decimal digits, suited to
+ * noise fields and other data with a wide dynamic range. Both are storage only: convert to f32
+ * to do arithmetic. Conversions round to nearest even; the span overloads of qm::convert use
+ * F16C or AVX2 when QM_F16C or QM_AVX2 is defined.
+ */
+
+namespace qm {
+
+namespace detail {
+
+// Float to half with round to nearest even (after Fabian Giesen). Values past the half range
+// become infinity and NaNs become a quiet NaN.
+constexpr u16 floatToHalf(f32 value)
+{
+    constexpr u32 Infinity = 255u << 23;
+    constexpr u32 HalfOverflow = (127u + 16u) << 23;
+    constexpr u32 SubnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    u32 x = std::bit_cast<u32>(value);
+    const u32 sign = x & 0x8000'0000u;
+    x ^= sign;
+
+    u32 half;
+    if (x >= HalfOverflow) {
+        half = x > Infinity ? 0x7E00u : 0x7C00u;
+    }
+    else if (x < (113u << 23)) {
+        // Adding the magic number lets the FPU round the subnormal mantissa into place
+        const f32 shifted = std::bit_cast<f32>(x) + std::bit_cast<f32>(SubnormalMagic);
+        half = std::bit_cast<u32>(shifted) - SubnormalMagic;
+    }
+    else {
+        const u32 mantissaOdd = (x >> 13) & 1u;
+        x += ((15u - 127u) << 23) + 0xFFFu + mantissaOdd;
+        half = x >> 13;
+    }
+    return static_cast<u16>(half | (sign >> 16));
+}
+
+constexpr f32 halfToFloat(u16 half)
+{
+    constexpr u32 ExponentMask = 0x7C00u << 13;
+    constexpr f32 SubnormalMagic = std::bit_cast<f32>(113u << 23);
+
+    u32 x = static_cast<u32>(half & 0x7FFFu) << 13;
+    const u32 exponent = x & ExponentMask;
+    x += (127u - 15u) << 23;
+    if (exponent == ExponentMask) {
+        x += (128u - 16u) << 23; // Infinity or NaN
+    }
+    else if (exponent == 0) {
+        x = std::bit_cast<u32>(std::bit_cast<f32>(x + (1u << 23)) - SubnormalMagic);
+    }
+    return std::bit_cast<f32>(x | (static_cast<u32>(half & 0x8000u) << 16));
+}
+
+// Float to bfloat16 with round to nearest even, keeping NaNs NaN.
+constexpr u16 floatToBFloat(f32 value)
+{
+    const u32 x = std::bit_cast<u32>(value);
+    if ((x & 0x7FFF'FFFFu) > 0x7F80'0000u) {
+        return static_cast<u16>((x >> 16) | 0x40u);
+    }
+    return static_cast<u16>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+}
+
+constexpr f32 bfloatToFloat(u16 bfloat)
+{
+    return std::bit_cast<f32>(static_cast<u32>(bfloat) << 16);
+}
+
+} // namespace detail
+
+/**
+ * @brief An IEEE 754 half-precision float, for storage.
+ *
+ * Example usage:
+ * @code
+ * qm::f16 stored(0.1f);
+ * f32 value = static_cast<f32>(stored); // 0.099975586
+ * @endcode
+ */
+struct f16 {
+    u16 bits = 0;
+
+    constexpr f16() = default;
+
+    /**
+     * @brief Converts from f32, rounding to nearest even.
+     */
+    explicit constexpr f16(f32 value) : bits{detail::floatToHalf(value)} {}
+
+    /**
+     * @brief Returns the value with the given bit pattern.
+     */
+    static constexpr f16 fromBits(u16 bits)
+    {
+        f16 result;
+        result.bits = bits;
+        return result;
+    }
+
+    /**
+     * @brief Converts to f32 exactly.
+     */
+    explicit constexpr operator f32() const { return detail::halfToFloat(bits); }
+};
+
+/**
+ * @brief A bfloat16 float (the top 16 bits of an f32), for storage.
+ *
+ * Example usage:
+ * @code
+ * qm::bf16 stored(1.0e20f);
+ * f32 value = static_cast<f32>(stored); // 1.0004e20
+ * @endcode
+ */
+struct bf16 {
+    u16 bits = 0;
+
+    constexpr bf16() = default;
+
+    /**
+     * @brief Converts from f32, rounding to nearest even.
+     */
+    explicit constexpr bf16(f32 value) : bits{detail::floatToBFloat(value)} {}
+
+    /**
+     * @brief Returns the value with the given bit pattern.
+     */
+    static constexpr bf16 fromBits(u16 bits)
+    {
+        bf16 result;
+        result.bits = bits;
+        return result;
+    }
+
+    /**
+     * @brief Converts to f32 exactly.
+     */
+    explicit constexpr operator f32() const { return detail::bfloatToFloat(bits); }
+};
+
+static_assert(sizeof(f16) == 2 && sizeof(bf16) == 2);
+
+/**
+ * @brief Converts floats to half precision.
+ * @param in The values.
+ * @param out Receives in.size() values.
+ */
+inline void convert(std::span<const f32> in, std::span<f16> out)
+{
+    QM_ASSERT(out.size() >= in.size());
+    std::size_t i = 0;
+
+#ifdef QM_F16C
+    for (; i + 8 <= in.size(); i += 8) {
+        const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(in.data() + i),
+                                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out.data() + i), halves);
+    }
+#endif
+
+    for (; i < in.size(); ++i) {
+        out[i] = f16(in[i]);
+    }
+}
+
+/**
+ * @brief Converts half-precision values to floats.
+ * @param in The values.
+ * @param out Receives in.size() values.
+ */
+inline void convert(std::span<const f16> in, std::span<f32> out)
+{
+    QM_ASSERT(out.size() >= in.size());
+    std::size_t i = 0;
+
+#ifdef QM_F16C
+    for (; i + 8 <= in.size(); i += 8) {
+        const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.data() + i));
+        _mm256_storeu_ps(out.data() + i, _mm256_cvtph_ps(halves));
+    }
+#endif
+
+    for (; i < in.size(); ++i) {
+        out[i] = static_cast<f32>(in[i]);
+    }
+}
+
+/**
+ * @brief Converts floats to bfloat16.
+ * @param in The values.
+ * @param out Receives in.size() values.
+ */
+inline void convert(std::span<const f32> in, std::span<bf16> out)
+{
+    QM_ASSERT(out.size() >= in.size());
+    std::size_t i = 0;
+
+#ifdef QM_AVX2
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i quiet = _mm256_set1_epi32(0x0040'0000);
+    for (; i + 16 <= in.size(); i += 16) {
+        __m256i rounded[2];
+        for (u32 half = 0; half < 2; ++half) {
+            const __m256 value = _mm256_loadu_ps(in.data() + i + 8 * half);
+            const __m256i x = _mm256_castps_si256(value);
+            const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(x, 16), one);
+            const __m256i nearest = _mm256_add_epi32(x, _mm256_add_epi32(bias, odd));
+            const __m256 isNaN = _mm256_cmp_ps(value, value, _CMP_UNORD_Q);
+            const __m256i result = _mm256_blendv_epi8(nearest, _mm256_or_si256(x, quiet),
+                                                      _mm256_castps_si256(isNaN));
+            rounded[half] = _mm256_srli_epi32(result, 16);
+        }
+
+        // Packing works within 128-bit lanes, so restore the order afterwards
+        const __m256i packed = _mm256_packus_epi32(rounded[0], rounded[1]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.data() + i),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+#endif
+
+    for (; i < in.size(); ++i) {
+        out[i] = bf16(in[i]);
+    }
+}
+
+/**
+ * @brief Converts bfloat16 values to floats.
+ * @param in The values.
+ * @param out Receives in.size() values.
+ */
+inline void convert(std::span<const bf16> in, std::span<f32> out)
+{
+    QM_ASSERT(out.size() >= in.size());
+    std::size_t i = 0;
+
+#ifdef QM_AVX2
+    for (; i + 8 <= in.size(); i += 8) {
+        const __m128i bfloats = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.data() + i));
+        const __m256i widened = _mm256_slli_epi32(_mm256_cvtepu16_epi32(bfloats), 16);
+        _mm256_storeu_ps(out.data() + i, _mm256_castsi256_ps(widened));
+    }
+#endif
+
+    for (; i < in.size(); ++i) {
+        out[i] = static_cast<f32>(in[i]);
+    }
+}
+
+/*
+ * Packed vectors store f16 or bf16 components at half the size of their f32 counterparts. They
+ * are storage only: unpack() to compute, and construct from a vec to store. The span overloads
+ * of qm::convert pack and unpack whole buffers with the SIMD paths above.
+ */
+
+/**
+ * @brief A two-component vector stored as f16 or bf16.
+ * @tparam S qm::f16 or qm::bf16.
+ */
+template <typename S>
+struct packed_vec2 {
+    S x;
+    S y;
+
+    constexpr packed_vec2() = default;
+    explicit constexpr packed_vec2(const vec2<f32> &v) : x{v.x}, y{v.y} {}
+
+    constexpr vec2<f32> unpack() const { return {static_cast<f32>(x), static_cast<f32>(y)}; }
+};
+
+/**
+ * @brief A three-component vector stored as f16 or bf16.
+ * @tparam S qm::f16 or qm::bf16.
+ */
+template <typename S>
+struct packed_vec3 {
+    S x;
+    S y;
+    S z;
+
+    constexpr packed_vec3() = default;
+    explicit constexpr packed_vec3(const vec3<f32> &v) : x{v.x}, y{v.y}, z{v.z} {}
+
+    constexpr vec3<f32> unpack() const
+    {
+        return {static_cast<f32>(x), static_cast<f32>(y), static_cast<f32>(z)};
+    }
+};
+
+/**
+ * @brief A four-component vector stored as f16 or bf16.
+ * @tparam S qm::f16 or qm::bf16.
+ */
+template <typename S>
+struct packed_vec4 {
+    S x;
+    S y;
+    S z;
+    S w;
+
+    constexpr packed_vec4() = default;
+    explicit constexpr packed_vec4(const vec4<f32> &v) : x{v.x}, y{v.y}, z{v.z}, w{v.w} {}
+
+    constexpr vec4<f32> unpack() const
+    {
+        return {static_cast<f32>(x), static_cast<f32>(y), static_cast<f32>(z),
+                static_cast<f32>(w)};
+    }
+};
+
+using vec2h = packed_vec2<f16>;
+using vec3h = packed_vec3<f16>;
+using vec4h = packed_vec4<f16>;
+using vec2bf = packed_vec2<bf16>;
+using vec3bf = packed_vec3<bf16>;
+using vec4bf = packed_vec4<bf16>;
+
+namespace detail {
+
+// Views a span of vectors as their components, which are laid out without padding.
+template <std::size_t N, typename S, typename V>
+std::span<S> components(std::span<V> vectors)
+{
+    static_assert(sizeof(V) == N * sizeof(S));
+    return {reinterpret_cast<S *>(vectors.data()), vectors.size() * N};
+}
+
+} // namespace detail
+
+/**
+ * @brief Packs vectors to half precision.
+ * @param in The vectors.
+ * @param out Receives in.size() vectors.
+ *
+ * Example usage:
+ * @code
+ * std::vector<qm::vec3h> stored(normals.size());
+ * qm::convert(normals, stored);
+ * @endcode
+ */
+inline void convert(std::span<const vec2<f32>> in, std::span<vec2h> out)
+{
+    convert(detail::components<2, const f32>(in), detail::components<2, f16>(out));
+}
+
+inline void convert(std::span<const vec3<f32>> in, std::span<vec3h> out)
+{
+    convert(detail::components<3, const f32>(in), detail::components<3, f16>(out));
+}
+
+inline void convert(std::span<const vec4<f32>> in, std::span<vec4h> out)
+{
+    convert(detail::components<4, const f32>(in), detail::components<4, f16>(out));
+}
+
+/**
+ * @brief Unpacks half-precision vectors.
+ * @param in The vectors.
+ * @param out Receives in.size() vectors.
+ */
+inline void convert(std::span<const vec2h> in, std::span<vec2<f32>> out)
+{
+    convert(detail::components<2, const f16>(in), detail::components<2, f32>(out));
+}
+
+inline void convert(std::span<const vec3h> in, std::span<vec3<f32>> out)
+{
+    convert(detail::components<3, const f16>(in), detail::components<3, f32>(out));
+}
+
+inline void convert(std::span<const vec4h> in, std::span<vec4<f32>> out)
+{
+    convert(detail::components<4, const f16>(in), detail::components<4, f32>(out));
+}
+
+/**
+ * @brief Packs vectors to bfloat16.
+ * @param in The vectors.
+ * @param out Receives in.size() vectors.
+ */
+inline void convert(std::span<const vec2<f32>> in, std::span<vec2bf> out)
+{
+    convert(detail::components<2, const f32>(in), detail::components<2, bf16>(out));
+}
+
+inline void convert(std::span<const vec3<f32>> in, std::span<vec3bf> out)
+{
+    convert(detail::components<3, const f32>(in), detail::components<3, bf16>(out));
+}
+
+inline void convert(std::span<const vec4<f32>> in, std::span<vec4bf> out)
+{
+    convert(detail::components<4, const f32>(in), detail::components<4, bf16>(out));
+}
+
+/**
+ * @brief Unpacks bfloat16 vectors.
+ * @param in The vectors.
+ * @param out Receives in.size() vectors.
+ */
+inline void convert(std::span<const vec2bf> in, std::span<vec2<f32>> out)
+{
+    convert(detail::components<2, const bf16>(in), detail::components<2, f32>(out));
+}
+
+inline void convert(std::span<const vec3bf> in, std::span<vec3<f32>> out)
+{
+    convert(detail::components<3, const bf16>(in), detail::components<3, f32>(out));
+}
+
+inline void convert(std::span<const vec4bf> in, std::span<vec4<f32>> out)
+{
+    convert(detail::components<4, const bf16>(in), detail::components<4, f32>(out));
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_HALF_HPP
@@ -0,0 +1,579 @@
+#ifndef QUIKMAFF_HULL_HPP
+#define QUIKMAFF_HULL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "predicates.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+namespace qm {
+
+namespace detail {
+
+// Twice the signed area of the triangle (a, b, c); positive when counter-clockwise.
+template <IsFloatingPointT T>
+constexpr T hullCross(const vec2<T> &a, const vec2<T> &b, const vec2<T> &c)
+{
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Double precision plane helpers; the vec3 members compute in float.
+inline f64 hullDot(const vec3<f64> &a, const vec3<f64> &b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline vec3<f64> hullCross(const vec3<f64> &a, const vec3<f64> &b)
+{
+    return vec3<f64>(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+inline vec3<f64> hullNormalize(const vec3<f64> &v)
+{
+    const f64 length = std::sqrt(hullDot(v, v));
+    return length > 0.0 ? vec3<f64>(v.x / length, v.y / length, v.z / length) : v;
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes the convex hull of a set of 2D points.
+ *
+ * Uses Andrew's monotone chain. Points strictly inside the octagon spanned by the extreme
+ * points along the axes and diagonals are first discarded (Akl-Toussaint), which removes most
+ * of the input for typical scans before sorting. No memory is allocated.
+ *
+ * @param points The input points.
+ * @param scratch Scratch buffer, at least as large as points.
+ * @param out Receives the hull in counter-clockwise order without collinear points. Must be
+ * at least as large as points.
+ * @return The number of hull vertices written to out.
+ *
+ * Example usage:
+ * @code
+ * std::vector<vec2f> scratch(points.size()), hull(points.size());
+ * hull.resize(qm::convexHull(std::span<const vec2f>(points), scratch, hull));
+ * @endcode
+ */
+template <IsFloatingPointT T>
+std::size_t convexHull(std::span<const vec2<T>> points, std::span<vec2<T>> scratch,
+                       std::span<vec2<T>> out)
+{
+    QM_ASSERT(scratch.size() >= points.size() && out.size() >= points.size());
+    if (points.empty()) {
+        return 0;
+    }
+
+    // Akl-Toussaint: extreme points in counter-clockwise order around the octagon
+    const vec2<T> *extremes[8] = {&points[0], &points[0], &points[0], &points[0],
+                                  &points[0], &points[0], &points[0], &points[0]};
+    for (const vec2<T> &p : points) {
+        if (p.x < extremes[0]->x) {
+            extremes[0] = &p;
+        }
+        if (p.x + p.y < extremes[1]->x + extremes[1]->y) {
+            extremes[1] = &p;
+        }
+        if (p.y < extremes[2]->y) {
+            extremes[2] = &p;
+        }
+        if (p.x - p.y > extremes[3]->x - extremes[3]->y) {
+            extremes[3] = &p;
+        }
+        if (p.x > extremes[4]->x) {
+            extremes[4] = &p;
+        }
+        if (p.x + p.y > extremes[5]->x + extremes[5]->y) {
+            extremes[5] = &p;
+        }
+        if (p.y > extremes[6]->y) {
+            extremes[6] = &p;
+        }
+        if (p.x - p.y < extremes[7]->x - extremes[7]->y) {
+            extremes[7] = &p;
+        }
+    }
+
+    vec2<T> octagon[8];
+    std::size_t corners = 0;
+    for (const vec2<T> *extreme : extremes) {
+        if (corners == 0 || *extreme != octagon[corners - 1]) {
+            octagon[corners++] = *extreme;
+        }
+    }
+    while (corners > 1 && octagon[corners - 1] == octagon[0]) {
+        --corners;
+    }
+
+    std::size_t count = 0;
+    for (const vec2<T> &p : points) {
+        bool inside = corners >= 3;
+        for (std::size_t i = 0; inside && i < corners; ++i) {
+            inside = detail::hullCross(octagon[i], octagon[(i + 1) % corners], p) > T(0);
+        }
+        if (!inside) {
+            scratch[count++] = p;
+        }
+    }
+
+    std::sort(scratch.begin(), scratch.begin() + count, [](const vec2<T> &a, const vec2<T> &b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+
+    if (scratch[0] == scratch[count - 1]) {
+        out[0] = scratch[0];
+        return 1;
+    }
+
+    // Lower chain, left to right, directly into the output
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        while (k >= 2 && detail::hullCross(out[k - 2], out[k - 1], scratch[i]) <= T(0)) {
+            --k;
+        }
+        out[k++] = scratch[i];
+    }
+
+    // Upper chain, right to left. Its stack grows down from the end of the scratch buffer and
+    // never overtakes the point being read, so no second buffer is needed.
+    std::size_t s = 0;
+    auto upper = [&](std::size_t j) -> vec2<T> & { return scratch[count - 1 - j]; };
+    for (std::size_t i = count; i-- > 0;) {
+        const vec2<T> p = scratch[i];
+        while (s >= 2 && detail::hullCross(upper(s - 2), upper(s - 1), p) <= T(0)) {
+            --s;
+        }
+        upper(s++) = p;
+    }
+
+    // Both chains share their end points
+    for (std::size_t j = 1; j + 1 < s; ++j) {
+        out[k++] = upper(j);
+    }
+    return k;
+}
+
+/**
+ * @brief Computes 3D convex hulls with the quickhull algorithm.
+ *
+ * Working storage is kept between builds, so hulling many point sets with one instance only
+ * allocates while the buffers grow to the largest input seen.
+ *
+ * @tparam T The floating-point type of the points.
+ *
+ * Example usage:
+ * @code
+ * qm::QuickHull<f32> quickHull;
+ * std::vector<u32> indices(6 * points.size());
+ * std::size_t triangles = quickHull.build(points, indices);
+ * @endcode
+ */
+template <IsFloatingPointT T>
+class QuickHull {
+public:
+    /**
+     * @brief Builds the hull of a point set.
+     * @param points The input points.
+     * @param outIndices Receives three point indices per hull triangle, wound counter-clockwise
+     * when seen from outside. A hull of n points has at most 2n - 4 triangles; triangles beyond
+     * the buffer's capacity are counted but not written.
+     * @return The number of hull triangles, or 0 if the points are coplanar.
+     */
+    std::size_t build(std::span<const vec3<T>> points, std::span<u32> outIndices)
+    {
+        m_points = points;
+        m_faces.clear();
+        m_freeFaces.clear();
+        m_pending.clear();
+
+        const std::size_t count = points.size();
+        if (count < 4) {
+            return 0;
+        }
+
+        // Size everything for the worst case up front so the main loop never allocates. A hull
+        // has at most 2n - 4 faces, and the cone (one face per horizon edge, at most n) is
+        // created before the visible faces are freed, so face slots peak below 3n. m_pending
+        // holds each slot at most once, and the flood fill only visits live faces.
+        m_next.assign(count, None);
+        m_newFaceByVertex.assign(count, None);
+        m_faces.reserve(3 * count);
+        m_freeFaces.reserve(3 * count);
+        m_pending.reserve(3 * count);
+        m_stack.reserve(2 * count);
+        m_visible.reserve(2 * count);
+        m_newFaces.reserve(count);
+        m_horizon.reserve(count);
+        m_visitMark = 0;
+
+        if (!createSimplex()) {
+            return 0;
+        }
+
+        // Assign every point to the face it is furthest outside of
+        for (u32 i = 0; i < count; ++i) {
+            if (i != m_simplex[0] && i != m_simplex[1] && i != m_simplex[2] &&
+                i != m_simplex[3]) {
+                assignPoint(i, std::array<u32, 4>{0, 1, 2, 3});
+            }
+        }
+        for (u32 face = 0; face < 4; ++face) {
+            if (m_faces[face].Outside != None) {
+                pushPending(face);
+            }
+        }
+
+        while (!m_pending.empty()) {
+            const u32 face = m_pending.back();
+            m_pending.pop_back();
+            m_faces[face].Pending = false;
+            if (m_faces[face].Alive && m_faces[face].Outside != None) {
+                addPoint(m_faces[face].Furthest, face);
+            }
+        }
+
+        std::size_t triangles = 0;
+        for (const Face &face : m_faces) {
+            if (!face.Alive) {
+                continue;
+            }
+            if (3 * triangles + 2 < outIndices.size()) {
+                for (u32 i = 0; i < 3; ++i) {
+                    outIndices[3 * triangles + i] = face.Vertices[i];
+                }
+            }
+            ++triangles;
+        }
+        return triangles;
+    }
+
+private:
+    static constexpr u32 None = 0xFFFFFFFFu;
+
+    struct Face {
+        u32 Vertices[3];
+        u32 Neighbours[3]; // Face across the edge Vertices[i] -> Vertices[(i + 1) % 3]
+        vec3<f64> Normal;
+        f64 Offset;
+        u32 Outside;  // Head of the linked list of points outside this face
+        u32 Furthest; // The outside point furthest from the plane
+        f64 FurthestDistance;
+        f64 Tolerance; // Bound on the rounding error of distance()
+        u32 VisitMark;
+        bool Alive;
+        bool Pending; // Queued in m_pending; kept across slot reuse so a slot is queued once
+    };
+
+    vec3<f64> point(u32 index) const { return vec3<f64>(m_points[index]); }
+
+    f64 distance(const Face &face, u32 index) const
+    {
+        return detail::hullDot(face.Normal, point(index)) - face.Offset;
+    }
+
+    // Whether a face sees a point is decided exactly, which keeps the visible region a disc
+    // however close to coplanar the input is. The plane distance settles it when it is clear
+    // of the face's rounding error, and otherwise falls through to the exact orientation test.
+    bool isAbove(const Face &face, u32 index, f64 &pointDistance) const
+    {
+        pointDistance = distance(face, index);
+        if (pointDistance > face.Tolerance) {
+            return true;
+        }
+        if (pointDistance < -face.Tolerance) {
+            return false;
+        }
+        return orient3d(m_points[face.Vertices[0]], m_points[face.Vertices[1]],
+                        m_points[face.Vertices[2]], m_points[index]) < 0.0;
+    }
+
+    u32 createFace(u32 a, u32 b, u32 c)
+    {
+        u32 index;
+        if (!m_freeFaces.empty()) {
+            index = m_freeFaces.back();
+            m_freeFaces.pop_back();
+        }
+        else {
+            index = static_cast<u32>(m_faces.size());
+            m_faces.emplace_back();
+        }
+
+        Face &face = m_faces[index];
+        face.Vertices[0] = a;
+        face.Vertices[1] = b;
+        face.Vertices[2] = c;
+        face.Neighbours[0] = face.Neighbours[1] = face.Neighbours[2] = None;
+        const vec3<f64> ab = point(b) - point(a);
+        const vec3<f64> ac = point(c) - point(a);
+        const vec3<f64> cross = detail::hullCross(ab, ac);
+        const vec3<f64> normal = detail::hullNormalize(cross);
+        face.Normal = normal;
+        face.Offset = detail::hullDot(normal, point(a));
+
+        // The normal's direction error grows as the triangle gets thinner
+        const f64 area = std::sqrt(detail::hullDot(cross, cross));
+        const f64 edges = std::sqrt(detail::hullDot(ab, ab) * detail::hullDot(ac, ac));
+        face.Tolerance = area > 0.0 ? 16.0 * std::numeric_limits<f64>::epsilon() * m_extent *
+                                          (edges / area + 1.0)
+                                    : std::numeric_limits<f64>::infinity();
+        face.Outside = None;
+        face.Furthest = None;
+        face.FurthestDistance = 0.0;
+        face.VisitMark = 0;
+        face.Alive = true;
+        return index;
+    }
+
+    bool createSimplex()
+    {
+        const std::size_t count = m_points.size();
+
+        u32 extremes[6] = {0, 0, 0, 0, 0, 0};
+        m_extent = 0.0;
+        for (u32 i = 0; i < count; ++i) {
+            const vec3<f64> p = point(i);
+            for (u32 axis = 0; axis < 3; ++axis) {
+                m_extent = qm::max(m_extent, qm::abs(p[axis]));
+                if (p[axis] < point(extremes[2 * axis])[axis]) {
+                    extremes[2 * axis] = i;
+                }
+                if (p[axis] > point(extremes[2 * axis + 1])[axis]) {
+                    extremes[2 * axis + 1] = i;
+                }
+            }
+        }
+
+        // The most distant pair of extreme points
+        f64 best = 0.0;
+        for (u32 i = 0; i < 6; ++i) {
+            for (u32 j = i + 1; j < 6; ++j) {
+                const vec3<f64> edge = point(extremes[i]) - point(extremes[j]);
+                const f64 d = detail::hullDot(edge, edge);
+                if (d > best) {
+                    best = d;
+                    m_simplex[0] = extremes[i];
+                    m_simplex[1] = extremes[j];
+                }
+            }
+        }
+        if (best == 0.0) {
+            return false;
+        }
+
+        // The point furthest from that line
+        const vec3<f64> origin = point(m_simplex[0]);
+        const vec3<f64> line = point(m_simplex[1]) - origin;
+        best = 0.0;
+        for (u32 i = 0; i < count; ++i) {
+            const vec3<f64> offset = detail::hullCross(line, point(i) - origin);
+            const f64 d = detail::hullDot(offset, offset);
+            if (d > best) {
+                best = d;
+                m_simplex[2] = i;
+            }
+        }
+        if (best == 0.0) {
+            return false;
+        }
+
+        // The point furthest from that plane
+        const vec3<f64> normal =
+            detail::hullNormalize(detail::hullCross(line, point(m_simplex[2]) - origin));
+        best = 0.0;
+        for (u32 i = 0; i < count; ++i) {
+            const f64 d = qm::abs(detail::hullDot(normal, point(i) - origin));
+            if (d > best) {
+                best = d;
+                m_simplex[3] = i;
+            }
+        }
+        // Rounding can hide exact degeneracy from the searches above, so settle it exactly,
+        // then wind the base so the apex is behind it
+        const f64 volume = orient3d(m_points[m_simplex[0]], m_points[m_simplex[1]],
+                                    m_points[m_simplex[2]], m_points[m_simplex[3]]);
+        if (volume == 0.0) {
+            return false;
+        }
+        if (volume < 0.0) {
+            std::swap(m_simplex[1], m_simplex[2]);
+        }
+
+        const u32 a = m_simplex[0], b = m_simplex[1], c = m_simplex[2], d = m_simplex[3];
+        createFace(a, b, c); // 0
+        createFace(a, d, b); // 1
+        createFace(b, d, c); // 2
+        createFace(c, d, a); // 3
+
+        // Neighbours across each edge
+        const u32 adjacency[4][3] = {{1, 2, 3}, {3, 2, 0}, {1, 3, 0}, {2, 1, 0}};
+        for (u32 face = 0; face < 4; ++face) {
+            for (u32 edge = 0; edge < 3; ++edge) {
+                m_faces[face].Neighbours[edge] = adjacency[face][edge];
+            }
+        }
+        return true;
+    }
+
+    // Adds a point to the outside set of whichever of the given faces it is furthest above.
+    template <typename FaceRange>
+    void assignPoint(u32 point, const FaceRange &faces)
+    {
+        u32 bestFace = None;
+        f64 bestDistance = 0.0;
+        for (const u32 face : faces) {
+            f64 d;
+            if (!isAbove(m_faces[face], point, d)) {
+                continue;
+            }
+            if (bestFace == None || d > bestDistance) {
+                bestDistance = d;
+                bestFace = face;
+            }
+        }
+        assignPointTo(point, bestFace, bestDistance);
+    }
+
+    void assignPointTo(u32 point, u32 faceIndex, f64 pointDistance)
+    {
+        if (faceIndex == None) {
+            return;
+        }
+        Face &face = m_faces[faceIndex];
+        m_next[point] = face.Outside;
+        face.Outside = point;
+        if (face.Furthest == None || pointDistance > face.FurthestDistance) {
+            face.Furthest = point;
+            face.FurthestDistance = pointDistance;
+        }
+    }
+
+    void addPoint(u32 eye, u32 startFace)
+    {
+        ++m_visitMark;
+        m_visible.clear();
+        m_horizon.clear();
+
+        // Flood fill the faces visible from the eye point, collecting the horizon edges
+        m_stack.clear();
+        m_stack.push_back(startFace);
+        m_faces[startFace].VisitMark = m_visitMark;
+        while (!m_stack.empty()) {
+            const u32 faceIndex = m_stack.back();
+            m_stack.pop_back();
+            m_visible.push_back(faceIndex);
+
+            for (u32 edge = 0; edge < 3; ++edge) {
+                const u32 neighbour = m_faces[faceIndex].Neighbours[edge];
+                Face &other = m_faces[neighbour];
+                if (other.VisitMark == m_visitMark) {
+                    continue;
+                }
+                f64 eyeDistance;
+                if (isAbove(other, eye, eyeDistance)) {
+                    other.VisitMark = m_visitMark;
+                    m_stack.push_back(neighbour);
+                }
+                else {
+                    m_horizon.push_back({faceIndex, edge});
+                }
+            }
+        }
+
+        // Cone of new faces from the horizon to the eye
+        m_newFaces.clear();
+        for (const HorizonEdge &edge : m_horizon) {
+            const Face &visible = m_faces[edge.Face];
+            const u32 a = visible.Vertices[edge.Edge];
+            const u32 b = visible.Vertices[(edge.Edge + 1) % 3];
+            const u32 outsideFace = visible.Neighbours[edge.Edge];
+
+            const u32 created = createFace(a, b, eye);
+            m_faces[created].Neighbours[0] = outsideFace;
+            Face &outside = m_faces[outsideFace];
+            for (u32 i = 0; i < 3; ++i) {
+                if (outside.Neighbours[i] == edge.Face && outside.Vertices[i] == b) {
+                    outside.Neighbours[i] = created;
+                }
+            }
+
+            m_newFaceByVertex[a] = created;
+            m_newFaces.push_back(created);
+        }
+
+        // Stitch the cone: edge (b, eye) meets the new face starting at b, and edge (eye, a)
+        // meets the new face ending at a
+        for (const u32 created : m_newFaces) {
+            Face &face = m_faces[created];
+            const u32 next = m_newFaceByVertex[face.Vertices[1]];
+            face.Neighbours[1] = next;
+            m_faces[next].Neighbours[2] = created;
+        }
+        for (const u32 created : m_newFaces) {
+            m_newFaceByVertex[m_faces[created].Vertices[0]] = None;
+        }
+
+        // Hand the outside points of the removed faces to the new faces
+        for (const u32 faceIndex : m_visible) {
+            Face &face = m_faces[faceIndex];
+            face.Alive = false;
+            u32 point = face.Outside;
+            face.Outside = None;
+            while (point != None) {
+                const u32 next = m_next[point];
+                if (point != eye) {
+                    assignPoint(point, m_newFaces);
+                }
+                point = next;
+            }
+        }
+        for (const u32 faceIndex : m_visible) {
+            m_freeFaces.push_back(faceIndex);
+        }
+
+        for (const u32 created : m_newFaces) {
+            if (m_faces[created].Outside != None) {
+                pushPending(created);
+            }
+        }
+    }
+
+    // A slot freed while still queued keeps its entry, which then serves the face reusing it
+    void pushPending(u32 faceIndex)
+    {
+        if (!m_faces[faceIndex].Pending) {
+            m_faces[faceIndex].Pending = true;
+            m_pending.push_back(faceIndex);
+        }
+    }
+
+private:
+    struct HorizonEdge {
+        u32 Face;
+        u32 Edge;
+    };
+
+    std::span<const vec3<T>> m_points;
+    std::vector<Face> m_faces;
+    std::vector<u32> m_freeFaces;
+    std::vector<u32> m_next;
+    std::vector<u32> m_newFaceByVertex;
+    std::vector<u32> m_pending;
+    std::vector<u32> m_stack;
+    std::vector<u32> m_visible;
+    std::vector<u32> m_newFaces;
+    std::vector<HorizonEdge> m_horizon;
+    u32 m_simplex[4] = {0, 0, 0, 0};
+    u32 m_visitMark = 0;
+    f64 m_extent = 0.0; // Largest coordinate magnitude, scaling the distance error bounds
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_HULL_HPP
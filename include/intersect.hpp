@@ -5,18 +5,19 @@
 
 namespace qm {
 
-template <typename T>
-bool sphereSphereIntersect(const Vec3 &center1, T radius1, const Vec3 &center2, T radius2)
+template <IsFloatingPointT T>
+bool sphereSphereIntersect(const vec3<T> &center1, T radius1, const vec3<T> &center2, T radius2)
 {
     // Calculate the distance between the centers of the spheres
-    T distance = distance(center1, center2);
+    T distance = (center2 - center1).length();
 
     // Check if the distance is less than the sum of the radii
     return distance <= (radius1 + radius2);
 }
 
-template <typename T>
-bool aabbIntersect(const Vec3 &min1, const Vec3 &max1, const Vec3 &min2, const Vec3 &max2)
+template <IsFloatingPointT T>
+bool aabbIntersect(const vec3<T> &min1, const vec3<T> &max1, const vec3<T> &min2,
+                   const vec3<T> &max2)
 {
     // Check for overlap along each axis
     bool xOverlap = (min1.x <= max2.x) && (max1.x >= min2.x);
@@ -27,26 +28,277 @@ bool aabbIntersect(const Vec3 &min1, const Vec3 &max1, const Vec3 &min2, const V
     return xOverlap && yOverlap && zOverlap;
 }
 
-template <typename T>
-bool raySphereIntersect(const Vec3 &rayOrigin, const Vec3 &rayDirection, const Vec3 &sphereCenter,
-                        T sphereRadius)
+template <IsFloatingPointT T>
+bool raySphereIntersect(const vec3<T> &rayOrigin, const vec3<T> &rayDirection,
+                        const vec3<T> &sphereCenter, T sphereRadius)
 {
     // Calculate the vector from the ray origin to the sphere center
-    Vec3 rayToSphere = sphereCenter - rayOrigin;
+    vec3<T> rayToSphere = sphereCenter - rayOrigin;
 
     // Calculate the projection of rayToSphere onto the ray direction
-    T t = dot(rayToSphere, rayDirection);
+    T t = rayToSphere.dot(rayDirection);
 
     // Calculate the closest point on the ray to the sphere center
-    Vec3 closestPoint = rayOrigin + t * rayDirection;
+    vec3<T> closestPoint = rayOrigin + rayDirection * t;
 
     // Calculate the distance between the closest point and the sphere center
-    T distance = distance(sphereCenter, closestPoint);
+    T distance = (sphereCenter - closestPoint).length();
 
     // Check if the distance is less than or equal to the sphere radius
     return distance <= sphereRadius;
 }
 
+/**
+ * @brief Intersects a ray with an axis-aligned box using the slab method.
+ *
+ * The ray direction is passed pre-inverted so the reciprocal can be shared across many boxes.
+ *
+ * @param rayOrigin Origin of the ray.
+ * @param invDirection Component-wise reciprocal of the ray direction.
+ * @param boxMin Minimum corner of the box.
+ * @param boxMax Maximum corner of the box.
+ * @param maxDistance Largest ray parameter to accept.
+ * @param tNear Receives the entry distance along the ray on a hit.
+ * @return True if the ray enters the box within [0, maxDistance].
+ */
+template <IsFloatingPointT T>
+bool rayAabbIntersect(const vec3<T> &rayOrigin, const vec3<T> &invDirection,
+                      const vec3<T> &boxMin, const vec3<T> &boxMax, T maxDistance, T &tNear)
+{
+    T t0 = static_cast<T>(0);
+    T t1 = maxDistance;
+
+    for (u32 axis = 0; axis < 3; ++axis) {
+        T tA = (boxMin[axis] - rayOrigin[axis]) * invDirection[axis];
+        T tB = (boxMax[axis] - rayOrigin[axis]) * invDirection[axis];
+        t0 = qm::max(t0, qm::min(tA, tB));
+        t1 = qm::min(t1, qm::max(tA, tB));
+    }
+
+    tNear = t0;
+    return t0 <= t1;
+}
+
+/**
+ * @brief Intersects a ray with a triangle (Moller-Trumbore).
+ * @param rayOrigin Origin of the ray.
+ * @param rayDirection Direction of the ray.
+ * @param v0 First triangle vertex.
+ * @param v1 Second triangle vertex.
+ * @param v2 Third triangle vertex.
+ * @param t Receives the distance along the ray on a hit.
+ * @param u Receives the barycentric weight of v1 on a hit.
+ * @param v Receives the barycentric weight of v2 on a hit.
+ * @return True if the ray hits the triangle at a positive distance.
+ */
+template <IsFloatingPointT T>
+bool rayTriangleIntersect(const vec3<T> &rayOrigin, const vec3<T> &rayDirection,
+                          const vec3<T> &v0, const vec3<T> &v1, const vec3<T> &v2, T &t, T &u,
+                          T &v)
+{
+    const vec3<T> edge1 = v1 - v0;
+    const vec3<T> edge2 = v2 - v0;
+    const vec3<T> p = rayDirection.cross(edge2);
+    const T det = edge1.dot(p);
+
+    // Ray is parallel to the triangle plane
+    if (qm::abs(det) < std::numeric_limits<T>::epsilon()) {
+        return false;
+    }
+
+    const T invDet = static_cast<T>(1) / det;
+    const vec3<T> s = rayOrigin - v0;
+    u = s.dot(p) * invDet;
+    if (u < static_cast<T>(0) || u > static_cast<T>(1)) {
+        return false;
+    }
+
+    const vec3<T> q = s.cross(edge1);
+    v = rayDirection.dot(q) * invDet;
+    if (v < static_cast<T>(0) || u + v > static_cast<T>(1)) {
+        return false;
+    }
+
+    t = edge2.dot(q) * invDet;
+    return t > static_cast<T>(0);
+}
+
+/**
+ * @brief Finds the point on a triangle closest to a given point.
+ * @param point The query point.
+ * @param a First triangle vertex.
+ * @param b Second triangle vertex.
+ * @param c Third triangle vertex.
+ * @return The closest point on (or inside) the triangle.
+ */
+template <IsFloatingPointT T>
+vec3<T> closestPointOnTriangle(const vec3<T> &point, const vec3<T> &a, const vec3<T> &b,
+                               const vec3<T> &c)
+{
+    const vec3<T> ab = b - a;
+    const vec3<T> ac = c - a;
+    const vec3<T> ap = point - a;
+
+    // Vertex region outside A
+    const T d1 = ab.dot(ap);
+    const T d2 = ac.dot(ap);
+    if (d1 <= static_cast<T>(0) && d2 <= static_cast<T>(0)) {
+        return a;
+    }
+
+    // Vertex region outside B
+    const vec3<T> bp = point - b;
+    const T d3 = ab.dot(bp);
+    const T d4 = ac.dot(bp);
+    if (d3 >= static_cast<T>(0) && d4 <= d3) {
+        return b;
+    }
+
+    // Edge region of AB
+    const T vc = d1 * d4 - d3 * d2;
+    if (vc <= static_cast<T>(0) && d1 >= static_cast<T>(0) && d3 <= static_cast<T>(0)) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    // Vertex region outside C
+    const vec3<T> cp = point - c;
+    const T d5 = ab.dot(cp);
+    const T d6 = ac.dot(cp);
+    if (d6 >= static_cast<T>(0) && d5 <= d6) {
+        return c;
+    }
+
+    // Edge region of AC
+    const T vb = d5 * d2 - d1 * d6;
+    if (vb <= static_cast<T>(0) && d2 >= static_cast<T>(0) && d6 <= static_cast<T>(0)) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    // Edge region of BC
+    const T va = d3 * d6 - d5 * d4;
+    if (va <= static_cast<T>(0) && (d4 - d3) >= static_cast<T>(0) &&
+        (d5 - d6) >= static_cast<T>(0)) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    // Inside the face
+    const T denom = static_cast<T>(1) / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+namespace detail {
+
+// Smallest root t >= 0 of |m + t * d|^2 = r^2, returning false if the ray misses.
+template <IsFloatingPointT T>
+bool sweepQuadratic(const vec3<T> &m, const vec3<T> &d, T radius, T &t)
+{
+    const T a = d.dot(d);
+    const T b = m.dot(d);
+    const T c = m.dot(m) - radius * radius;
+    if (a <= static_cast<T>(0) || b > static_cast<T>(0)) {
+        return false;
+    }
+
+    const T discriminant = b * b - a * c;
+    if (discriminant < static_cast<T>(0)) {
+        return false;
+    }
+
+    t = qm::max(static_cast<T>(0), (-b - qm::sqrt(discriminant)) / a);
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Sweeps a sphere along a ray and finds the first contact with a triangle.
+ *
+ * Contact is tested against the triangle face, then against the capsules around its edges and
+ * the spheres around its vertices; the earliest of these is the first time of impact.
+ *
+ * @param origin Starting centre of the sphere.
+ * @param direction Direction of travel.
+ * @param radius Radius of the sphere.
+ * @param v0 First triangle vertex.
+ * @param v1 Second triangle vertex.
+ * @param v2 Third triangle vertex.
+ * @param t Receives the distance along the ray at first contact.
+ * @return True if the sphere touches the triangle at a non-negative distance.
+ */
+template <IsFloatingPointT T>
+bool sphereSweepTriangle(const vec3<T> &origin, const vec3<T> &direction, T radius,
+                         const vec3<T> &v0, const vec3<T> &v1, const vec3<T> &v2, T &t)
+{
+    const T zero = static_cast<T>(0);
+
+    // Already overlapping at the start of the sweep
+    if ((closestPointOnTriangle(origin, v0, v1, v2) - origin).lengthSquared() <=
+        radius * radius) {
+        t = zero;
+        return true;
+    }
+
+    // Face contact: the sphere touches the plane inside the triangle
+    vec3<T> normal = (v1 - v0).cross(v2 - v0);
+    if (normal.lengthSquared() > zero) {
+        normal.normalize();
+        const T distance = (origin - v0).dot(normal);
+        const T approach = direction.dot(normal);
+        const T side = distance >= zero ? static_cast<T>(1) : static_cast<T>(-1);
+
+        if (approach * side < zero) {
+            const T tPlane = (side * radius - distance) / approach;
+            const vec3<T> contact = origin + direction * tPlane - normal * (side * radius);
+            const bool inside = (v1 - v0).cross(contact - v0).dot(normal) >= zero &&
+                                (v2 - v1).cross(contact - v1).dot(normal) >= zero &&
+                                (v0 - v2).cross(contact - v2).dot(normal) >= zero;
+            if (tPlane >= zero && inside) {
+                t = tPlane;
+                return true;
+            }
+        }
+    }
+
+    bool hit = false;
+    T best = std::numeric_limits<T>::max();
+    T candidate;
+
+    // Vertex spheres
+    for (const vec3<T> *vertex : {&v0, &v1, &v2}) {
+        if (detail::sweepQuadratic(origin - *vertex, direction, radius, candidate) &&
+            candidate < best) {
+            best = candidate;
+            hit = true;
+        }
+    }
+
+    // Edge cylinders, clamped to the edge segment
+    const vec3<T> *edges[3][2] = {{&v0, &v1}, {&v1, &v2}, {&v2, &v0}};
+    for (const auto &edge : edges) {
+        const vec3<T> ab = *edge[1] - *edge[0];
+        const T abLengthSq = ab.dot(ab);
+        if (abLengthSq <= zero) {
+            continue;
+        }
+
+        const vec3<T> ao = origin - *edge[0];
+        const vec3<T> m = ao - ab * (ao.dot(ab) / abLengthSq);
+        const vec3<T> d = direction - ab * (direction.dot(ab) / abLengthSq);
+        if (detail::sweepQuadratic(m, d, radius, candidate) && candidate < best) {
+            const T s = (ao + direction * candidate).dot(ab) / abLengthSq;
+            if (s >= zero && s <= static_cast<T>(1)) {
+                best = candidate;
+                hit = true;
+            }
+        }
+    }
+
+    if (hit) {
+        t = best;
+    }
+    return hit;
+}
+
 } // namespace qm
 
-#endif // QUIKMAFF_INTERSECT_HPP
\ No newline at end of file
+#endif // QUIKMAFF_INTERSECT_HPP
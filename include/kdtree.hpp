@@ -0,0 +1,317 @@
+#ifndef QUIKMAFF_KDTREE_HPP
+#define QUIKMAFF_KDTREE_HPP
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "parallel.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+namespace qm {
+
+/**
+ * @brief A point returned by a KdTree query.
+ * @tparam D The distance type of the tree.
+ */
+template <typename D>
+struct KdNeighbour {
+    u32 index;         ///< Index of the point in the span the tree was built from
+    D distanceSquared; ///< Squared distance from the query point
+};
+
+/**
+ * @brief A static k-d tree over a point cloud of vec2 or vec3 points.
+ *
+ * The tree uses an implicit, pointer-free balanced layout: the points of a subtree occupy a
+ * contiguous range whose median element is the subtree root, with the left and right subtrees
+ * on either side of it. Only the split axis of each node is stored alongside the reordered
+ * points, and ranges of a few points are left unsplit and scanned linearly.
+ *
+ * @tparam VecT The point type, vec2<T> or vec3<T>.
+ *
+ * Example usage:
+ * @code
+ * qm::KdTree<vec3f> tree;
+ * tree.build(points);
+ *
+ * std::array<qm::KdNeighbour<f32>, 8> neighbours;
+ * std::size_t found = tree.nearest(query, neighbours); // Eight closest points, nearest first.
+ * @endcode
+ */
+template <typename VecT>
+class KdTree {
+public:
+    using Scalar = std::remove_cvref_t<decltype(VecT::x)>;
+    using Distance = std::conditional_t<IsFloatingPointT<Scalar>, Scalar, f64>;
+    using Neighbour = KdNeighbour<Distance>;
+
+    static constexpr u32 Dimensions = static_cast<u32>(VecT::componentCount());
+
+    /**
+     * @brief Builds the tree, copying and reordering the points.
+     * @param points The point cloud.
+     * @param threadCount Number of threads to build with, 0 for one per hardware thread.
+     */
+    void build(std::span<const VecT> points, u32 threadCount = 0)
+    {
+        const std::size_t count = points.size();
+
+        // Points and their original indices are partitioned together while building
+        std::vector<BuildEntry> entries(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            entries[i] = {points[i], static_cast<u32>(i)};
+        }
+        m_axes.assign(count, 0);
+
+        // Subtrees above this depth are built on their own threads
+        u32 parallelDepth = 0;
+        for (u32 threads = resolveThreadCount(threadCount); threads > 1; threads >>= 1) {
+            ++parallelDepth;
+        }
+
+        buildRange(entries, 0, count, parallelDepth);
+
+        m_points.resize(count);
+        m_indices.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            m_points[i] = entries[i].Point;
+            m_indices[i] = entries[i].Index;
+        }
+    }
+
+    /**
+     * @brief Returns the number of points in the tree.
+     */
+    std::size_t size() const { return m_points.size(); }
+
+    /**
+     * @brief Finds the k nearest points to a query, where k is the size of the output span.
+     * @param query The query point.
+     * @param out Receives the neighbours, sorted nearest first.
+     * @param maxDistanceSquared Optional squared search radius.
+     * @return The number of neighbours written to out.
+     */
+    std::size_t nearest(const VecT &query, std::span<Neighbour> out,
+                        Distance maxDistanceSquared = std::numeric_limits<Distance>::max()) const
+    {
+        if (out.empty() || m_points.empty()) {
+            return 0;
+        }
+
+        // out doubles as a bounded max-heap on distance
+        std::size_t found = 0;
+        auto farther = [](const Neighbour &a, const Neighbour &b) {
+            return a.distanceSquared < b.distanceSquared;
+        };
+
+        search(query, maxDistanceSquared, [&](u32 position, Distance distanceSquared) {
+            if (found < out.size()) {
+                out[found++] = {m_indices[position], distanceSquared};
+                std::push_heap(out.begin(), out.begin() + found, farther);
+            }
+            else {
+                std::pop_heap(out.begin(), out.end(), farther);
+                out.back() = {m_indices[position], distanceSquared};
+                std::push_heap(out.begin(), out.end(), farther);
+            }
+            return found < out.size() ? maxDistanceSquared : out.front().distanceSquared;
+        });
+
+        std::sort_heap(out.begin(), out.begin() + found, farther);
+        return found;
+    }
+
+    /**
+     * @brief Finds all points within a radius of a query, in no particular order.
+     * @param query The query point.
+     * @param radius The search radius.
+     * @param out Receives the neighbours; results beyond its size are counted but dropped.
+     * @return The total number of points within the radius.
+     */
+    std::size_t radiusSearch(const VecT &query, Scalar radius, std::span<Neighbour> out) const
+    {
+        const Distance radiusSquared =
+            static_cast<Distance>(radius) * static_cast<Distance>(radius);
+        std::size_t found = 0;
+
+        if (m_points.empty()) {
+            return 0;
+        }
+
+        search(query, radiusSquared, [&](u32 position, Distance distanceSquared) {
+            if (found < out.size()) {
+                out[found] = {m_indices[position], distanceSquared};
+            }
+            ++found;
+            return radiusSquared;
+        });
+
+        return found;
+    }
+
+    /**
+     * @brief Runs k-nearest queries for many points across threads.
+     * @param queries The query points.
+     * @param k Number of neighbours per query.
+     * @param out Receives k neighbours per query, query-major and nearest first. Must hold
+     * queries.size() * k entries.
+     * @param counts Receives the number of neighbours found for each query.
+     * @param threadCount Number of threads to use, 0 for one per hardware thread.
+     */
+    void nearestBatch(std::span<const VecT> queries, u32 k, std::span<Neighbour> out,
+                      std::span<u32> counts, u32 threadCount = 0) const
+    {
+        QM_ASSERT(out.size() >= queries.size() * k);
+        QM_ASSERT(counts.size() >= queries.size());
+
+        parallelFor(queries.size(), threadCount, [&](std::size_t begin, std::size_t end, u32) {
+            for (std::size_t i = begin; i < end; ++i) {
+                counts[i] = static_cast<u32>(nearest(queries[i], out.subspan(i * k, k)));
+            }
+        });
+    }
+
+private:
+    struct BuildEntry {
+        VecT Point;
+        u32 Index;
+    };
+
+    static constexpr u32 StackSize = 64;
+    static constexpr u32 LeafSize = 8;
+
+    static Distance axisDistance(const VecT &a, const VecT &b, u32 axis)
+    {
+        return static_cast<Distance>(a[axis]) - static_cast<Distance>(b[axis]);
+    }
+
+    static Distance distanceSquared(const VecT &a, const VecT &b)
+    {
+        const Distance dx = static_cast<Distance>(a.x) - static_cast<Distance>(b.x);
+        const Distance dy = static_cast<Distance>(a.y) - static_cast<Distance>(b.y);
+        if constexpr (Dimensions == 3) {
+            const Distance dz = static_cast<Distance>(a.z) - static_cast<Distance>(b.z);
+            return dx * dx + dy * dy + dz * dz;
+        }
+        else {
+            return dx * dx + dy * dy;
+        }
+    }
+
+    void buildRange(std::vector<BuildEntry> &entries, std::size_t begin, std::size_t end,
+                    u32 parallelDepth)
+    {
+        if (end - begin <= LeafSize) {
+            return;
+        }
+
+        // Split along the axis of greatest spread
+        VecT lo = entries[begin].Point;
+        VecT hi = entries[begin].Point;
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            for (u32 axis = 0; axis < Dimensions; ++axis) {
+                lo[axis] = qm::min(lo[axis], entries[i].Point[axis]);
+                hi[axis] = qm::max(hi[axis], entries[i].Point[axis]);
+            }
+        }
+
+        u32 splitAxis = 0;
+        for (u32 axis = 1; axis < Dimensions; ++axis) {
+            if (axisDistance(hi, lo, axis) > axisDistance(hi, lo, splitAxis)) {
+                splitAxis = axis;
+            }
+        }
+
+        const std::size_t middle = begin + (end - begin) / 2;
+        std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end,
+                         [splitAxis](const BuildEntry &a, const BuildEntry &b) {
+                             return a.Point[splitAxis] < b.Point[splitAxis];
+                         });
+        m_axes[middle] = static_cast<u8>(splitAxis);
+
+        if (parallelDepth > 0) {
+            std::thread left([this, &entries, begin, middle, parallelDepth] {
+                buildRange(entries, begin, middle, parallelDepth - 1);
+            });
+            buildRange(entries, middle + 1, end, parallelDepth - 1);
+            left.join();
+        }
+        else {
+            buildRange(entries, begin, middle, 0);
+            buildRange(entries, middle + 1, end, 0);
+        }
+    }
+
+    // Depth-first, near-side-first traversal. visit(position, distanceSquared) is called for
+    // every point within the current bound and returns the new (possibly shrunken) bound.
+    template <typename VisitFn>
+    void search(const VecT &query, Distance bound, VisitFn &&visit) const
+    {
+        struct StackEntry {
+            u32 Begin;
+            u32 End;
+            Distance MinDistanceSquared;
+        };
+        StackEntry stack[StackSize];
+        u32 stackSize = 0;
+        stack[stackSize++] = {0, static_cast<u32>(m_points.size()), 0};
+
+        while (stackSize > 0) {
+            const StackEntry entry = stack[--stackSize];
+            if (entry.MinDistanceSquared > bound) {
+                continue;
+            }
+
+            u32 begin = entry.Begin;
+            u32 end = entry.End;
+            while (end - begin > LeafSize) {
+                const u32 middle = begin + (end - begin) / 2;
+                const VecT &point = m_points[middle];
+
+                const Distance pointDistance = distanceSquared(query, point);
+                if (pointDistance <= bound) {
+                    bound = visit(middle, pointDistance);
+                }
+
+                const u32 axis = m_axes[middle];
+                const Distance planeDistance = axisDistance(query, point, axis);
+                const Distance planeDistanceSquared = planeDistance * planeDistance;
+
+                // Defer the far side and descend into the near side
+                if (planeDistance < 0) {
+                    if (middle + 1 < end && planeDistanceSquared <= bound) {
+                        QM_ASSERT(stackSize < StackSize);
+                        stack[stackSize++] = {middle + 1, end, planeDistanceSquared};
+                    }
+                    end = middle;
+                }
+                else {
+                    if (begin < middle && planeDistanceSquared <= bound) {
+                        QM_ASSERT(stackSize < StackSize);
+                        stack[stackSize++] = {begin, middle, planeDistanceSquared};
+                    }
+                    begin = middle + 1;
+                }
+            }
+
+            // Small ranges are left unsplit and scanned linearly
+            for (u32 i = begin; i < end; ++i) {
+                const Distance pointDistance = distanceSquared(query, m_points[i]);
+                if (pointDistance <= bound) {
+                    bound = visit(i, pointDistance);
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<VecT> m_points;
+    std::vector<u32> m_indices;
+    std::vector<u8> m_axes;
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_KDTREE_HPP
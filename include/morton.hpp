@@ -0,0 +1,404 @@
+#ifndef QUIKMAFF_MORTON_HPP
+#define QUIKMAFF_MORTON_HPP
+
+#include <span>
+
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+#ifdef QM_BMI2
+#include <immintrin.h>
+#endif
+
+/**
+ * Morton (Z-order) and Hilbert space-filling curve keys.
+ *
+ * 2D keys interleave two 32-bit coordinates into 64 bits and 3D keys interleave three 21-bit
+ * coordinates into 63 bits, with the x coordinate in the least significant position. When BMI2
+ * is available the interleaving uses pdep/pext, otherwise a portable magic-bits version.
+ */
+
+namespace qm {
+
+namespace detail {
+
+constexpr u64 MortonMask2X = 0x5555555555555555ULL;
+constexpr u64 MortonMask3X = 0x1249249249249249ULL;
+
+constexpr u64 spreadBits2(u64 x)
+{
+    x &= 0xFFFFFFFFULL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+constexpr u64 compactBits2(u64 x)
+{
+    x &= 0x5555555555555555ULL;
+    x = (x | (x >> 1)) & 0x3333333333333333ULL;
+    x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return x;
+}
+
+constexpr u64 spreadBits3(u64 x)
+{
+    x &= 0x1FFFFFULL;
+    x = (x | (x << 32)) & 0x001F00000000FFFFULL;
+    x = (x | (x << 16)) & 0x001F0000FF0000FFULL;
+    x = (x | (x << 8)) & 0x100F00F00F00F00FULL;
+    x = (x | (x << 4)) & 0x10C30C30C30C30C3ULL;
+    x = (x | (x << 2)) & 0x1249249249249249ULL;
+    return x;
+}
+
+constexpr u64 compactBits3(u64 x)
+{
+    x &= 0x1249249249249249ULL;
+    x = (x ^ (x >> 2)) & 0x10C30C30C30C30C3ULL;
+    x = (x ^ (x >> 4)) & 0x100F00F00F00F00FULL;
+    x = (x ^ (x >> 8)) & 0x001F0000FF0000FFULL;
+    x = (x ^ (x >> 16)) & 0x001F00000000FFFFULL;
+    x = (x ^ (x >> 32)) & 0x00000000001FFFFFULL;
+    return x;
+}
+
+constexpr u64 interleave2(u64 x, u64 y)
+{
+    if !consteval {
+#ifdef QM_BMI2
+        return _pdep_u64(x, MortonMask2X) | _pdep_u64(y, MortonMask2X << 1);
+#endif
+    }
+    return spreadBits2(x) | (spreadBits2(y) << 1);
+}
+
+constexpr u64 interleave3(u64 x, u64 y, u64 z)
+{
+    if !consteval {
+#ifdef QM_BMI2
+        return _pdep_u64(x, MortonMask3X) | _pdep_u64(y, MortonMask3X << 1) |
+               _pdep_u64(z, MortonMask3X << 2);
+#endif
+    }
+    return spreadBits3(x) | (spreadBits3(y) << 1) | (spreadBits3(z) << 2);
+}
+
+constexpr u64 deinterleave2(u64 key, u32 axis)
+{
+    if !consteval {
+#ifdef QM_BMI2
+        return _pext_u64(key, MortonMask2X << axis);
+#endif
+    }
+    return compactBits2(key >> axis);
+}
+
+constexpr u64 deinterleave3(u64 key, u32 axis)
+{
+    if !consteval {
+#ifdef QM_BMI2
+        return _pext_u64(key, MortonMask3X << axis);
+#endif
+    }
+    return compactBits3(key >> axis);
+}
+
+// Skilling's transform between axis coordinates and the transposed Hilbert index
+// ("Programming the Hilbert curve", 2004), for Dimensions axes of Bits bits each.
+template <u32 Dimensions>
+constexpr void axesToTranspose(u32 (&axes)[Dimensions], u32 bits)
+{
+    const u32 highBit = 1u << (bits - 1);
+
+    // Inverse undo
+    for (u32 q = highBit; q > 1; q >>= 1) {
+        const u32 p = q - 1;
+        for (u32 i = 0; i < Dimensions; ++i) {
+            if (axes[i] & q) {
+                axes[0] ^= p;
+            }
+            else {
+                const u32 t = (axes[0] ^ axes[i]) & p;
+                axes[0] ^= t;
+                axes[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for (u32 i = 1; i < Dimensions; ++i) {
+        axes[i] ^= axes[i - 1];
+    }
+    u32 t = 0;
+    for (u32 q = highBit; q > 1; q >>= 1) {
+        if (axes[Dimensions - 1] & q) {
+            t ^= q - 1;
+        }
+    }
+    for (u32 i = 0; i < Dimensions; ++i) {
+        axes[i] ^= t;
+    }
+}
+
+template <u32 Dimensions>
+constexpr void transposeToAxes(u32 (&axes)[Dimensions], u32 bits)
+{
+    const u64 end = 2ULL << (bits - 1);
+
+    // Gray decode
+    u32 t = axes[Dimensions - 1] >> 1;
+    for (u32 i = Dimensions - 1; i > 0; --i) {
+        axes[i] ^= axes[i - 1];
+    }
+    axes[0] ^= t;
+
+    // Undo excess work
+    for (u64 q = 2; q != end; q <<= 1) {
+        const u32 p = static_cast<u32>(q - 1);
+        for (u32 i = Dimensions; i-- > 0;) {
+            if (axes[i] & q) {
+                axes[0] ^= p;
+            }
+            else {
+                t = (axes[0] ^ axes[i]) & p;
+                axes[0] ^= t;
+                axes[i] ^= t;
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Encodes a 2D integer coordinate as a 64-bit Morton key.
+ * @param v The coordinate; each component is reinterpreted as a 32-bit unsigned value.
+ * @return The Morton key.
+ *
+ * Example usage:
+ * @code
+ * u64 key = qm::mortonEncode(vec2i(3, 5)); // Bits of x and y interleaved, x first.
+ * @endcode
+ */
+template <IsIntegerT T>
+constexpr u64 mortonEncode(const vec2<T> &v)
+{
+    return detail::interleave2(static_cast<u32>(v.x), static_cast<u32>(v.y));
+}
+
+/**
+ * @brief Encodes a 3D integer coordinate as a 63-bit Morton key.
+ * @param v The coordinate; only the low 21 bits of each component are used.
+ * @return The Morton key.
+ */
+template <IsIntegerT T>
+constexpr u64 mortonEncode(const vec3<T> &v)
+{
+    return detail::interleave3(static_cast<u32>(v.x) & 0x1FFFFFu, static_cast<u32>(v.y) & 0x1FFFFFu,
+                               static_cast<u32>(v.z) & 0x1FFFFFu);
+}
+
+/**
+ * @brief Decodes a 64-bit Morton key into a 2D coordinate.
+ * @param key The Morton key.
+ * @return The coordinate.
+ */
+constexpr vec2<u32> mortonDecode2(u64 key)
+{
+    return vec2<u32>(static_cast<u32>(detail::deinterleave2(key, 0)),
+                     static_cast<u32>(detail::deinterleave2(key, 1)));
+}
+
+/**
+ * @brief Decodes a 63-bit Morton key into a 3D coordinate.
+ * @param key The Morton key.
+ * @return The coordinate.
+ */
+constexpr vec3<u32> mortonDecode3(u64 key)
+{
+    return vec3<u32>(static_cast<u32>(detail::deinterleave3(key, 0)),
+                     static_cast<u32>(detail::deinterleave3(key, 1)),
+                     static_cast<u32>(detail::deinterleave3(key, 2)));
+}
+
+/**
+ * @brief Encodes a 2D integer coordinate as a 64-bit Hilbert key.
+ *
+ * Consecutive Hilbert keys are always adjacent cells, which gives better locality than Morton
+ * order at a slightly higher encoding cost.
+ *
+ * @param v The coordinate; each component is reinterpreted as a 32-bit unsigned value.
+ * @return The Hilbert key.
+ */
+template <IsIntegerT T>
+constexpr u64 hilbertEncode(const vec2<T> &v)
+{
+    u32 axes[2] = {static_cast<u32>(v.x), static_cast<u32>(v.y)};
+    detail::axesToTranspose(axes, 32);
+    return detail::interleave2(axes[1], axes[0]);
+}
+
+/**
+ * @brief Encodes a 3D integer coordinate as a 63-bit Hilbert key.
+ * @param v The coordinate; only the low 21 bits of each component are used.
+ * @return The Hilbert key.
+ */
+template <IsIntegerT T>
+constexpr u64 hilbertEncode(const vec3<T> &v)
+{
+    u32 axes[3] = {static_cast<u32>(v.x) & 0x1FFFFFu, static_cast<u32>(v.y) & 0x1FFFFFu,
+                   static_cast<u32>(v.z) & 0x1FFFFFu};
+    detail::axesToTranspose(axes, 21);
+    return detail::interleave3(axes[2], axes[1], axes[0]);
+}
+
+/**
+ * @brief Decodes a 64-bit Hilbert key into a 2D coordinate.
+ * @param key The Hilbert key.
+ * @return The coordinate.
+ */
+constexpr vec2<u32> hilbertDecode2(u64 key)
+{
+    u32 axes[2] = {static_cast<u32>(detail::deinterleave2(key, 1)),
+                   static_cast<u32>(detail::deinterleave2(key, 0))};
+    detail::transposeToAxes(axes, 32);
+    return vec2<u32>(axes[0], axes[1]);
+}
+
+/**
+ * @brief Decodes a 63-bit Hilbert key into a 3D coordinate.
+ * @param key The Hilbert key.
+ * @return The coordinate.
+ */
+constexpr vec3<u32> hilbertDecode3(u64 key)
+{
+    u32 axes[3] = {static_cast<u32>(detail::deinterleave3(key, 2)),
+                   static_cast<u32>(detail::deinterleave3(key, 1)),
+                   static_cast<u32>(detail::deinterleave3(key, 0))};
+    detail::transposeToAxes(axes, 21);
+    return vec3<u32>(axes[0], axes[1], axes[2]);
+}
+
+/**
+ * @brief Quantizes a point inside a bounding box onto a 2^21 grid per axis.
+ * @param point The point to quantize.
+ * @param boundsMin Minimum corner of the bounds.
+ * @param boundsMax Maximum corner of the bounds.
+ * @return The grid coordinate, clamped to the bounds.
+ */
+constexpr vec3<u32> quantizePoint(const vec3<f32> &point, const vec3<f32> &boundsMin,
+                                  const vec3<f32> &boundsMax)
+{
+    constexpr f32 gridMax = static_cast<f32>(0x1FFFFF);
+    vec3<u32> result;
+    for (u32 axis = 0; axis < 3; ++axis) {
+        const f32 extent = boundsMax[axis] - boundsMin[axis];
+        const f32 scale = extent > 0.0f ? gridMax / extent : 0.0f;
+        const f32 cell = (point[axis] - boundsMin[axis]) * scale;
+        result[axis] = static_cast<u32>(qm::clamp(cell, 0.0f, gridMax));
+    }
+    return result;
+}
+
+/**
+ * @brief Encodes a point inside a bounding box as a 63-bit Morton key.
+ * @param point The point to encode.
+ * @param boundsMin Minimum corner of the bounds.
+ * @param boundsMax Maximum corner of the bounds.
+ * @return The Morton key of the quantized point.
+ */
+constexpr u64 mortonEncode(const vec3<f32> &point, const vec3<f32> &boundsMin,
+                           const vec3<f32> &boundsMax)
+{
+    return mortonEncode(quantizePoint(point, boundsMin, boundsMax));
+}
+
+/**
+ * @brief Encodes a point inside a bounding box as a 63-bit Hilbert key.
+ * @param point The point to encode.
+ * @param boundsMin Minimum corner of the bounds.
+ * @param boundsMax Maximum corner of the bounds.
+ * @return The Hilbert key of the quantized point.
+ */
+constexpr u64 hilbertEncode(const vec3<f32> &point, const vec3<f32> &boundsMin,
+                            const vec3<f32> &boundsMax)
+{
+    return hilbertEncode(quantizePoint(point, boundsMin, boundsMax));
+}
+
+/**
+ * @brief Encodes a span of integer coordinates as Morton keys.
+ * @param points The coordinates.
+ * @param keys Receives one key per coordinate.
+ */
+template <typename VecT>
+void mortonEncode(std::span<const VecT> points, std::span<u64> keys)
+{
+    QM_ASSERT(keys.size() >= points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keys[i] = mortonEncode(points[i]);
+    }
+}
+
+/**
+ * @brief Encodes a span of integer coordinates as Hilbert keys.
+ * @param points The coordinates.
+ * @param keys Receives one key per coordinate.
+ */
+template <typename VecT>
+void hilbertEncode(std::span<const VecT> points, std::span<u64> keys)
+{
+    QM_ASSERT(keys.size() >= points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keys[i] = hilbertEncode(points[i]);
+    }
+}
+
+/**
+ * @brief Encodes a span of points inside a bounding box as Morton keys.
+ * @param points The points.
+ * @param boundsMin Minimum corner of the bounds.
+ * @param boundsMax Maximum corner of the bounds.
+ * @param keys Receives one key per point.
+ *
+ * Example usage:
+ * @code
+ * std::vector<u64> keys(positions.size());
+ * qm::mortonEncode(std::span<const vec3f>(positions), sceneMin, sceneMax, keys);
+ * @endcode
+ */
+inline void mortonEncode(std::span<const vec3<f32>> points, const vec3<f32> &boundsMin,
+                         const vec3<f32> &boundsMax, std::span<u64> keys)
+{
+    QM_ASSERT(keys.size() >= points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keys[i] = mortonEncode(points[i], boundsMin, boundsMax);
+    }
+}
+
+/**
+ * @brief Encodes a span of points inside a bounding box as Hilbert keys.
+ * @param points The points.
+ * @param boundsMin Minimum corner of the bounds.
+ * @param boundsMax Maximum corner of the bounds.
+ * @param keys Receives one key per point.
+ */
+inline void hilbertEncode(std::span<const vec3<f32>> points, const vec3<f32> &boundsMin,
+                          const vec3<f32> &boundsMax, std::span<u64> keys)
+{
+    QM_ASSERT(keys.size() >= points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keys[i] = hilbertEncode(points[i], boundsMin, boundsMax);
+    }
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_MORTON_HPP
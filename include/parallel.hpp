@@ -0,0 +1,206 @@
+#ifndef QUIKMAFF_PARALLEL_HPP
+#define QUIKMAFF_PARALLEL_HPP
+
+#include <algorithm>
+#include <barrier>
+#include <thread>
+#include <vector>
+
+#include "base.hpp"
+#include "functions.hpp"
+
+namespace qm {
+
+/**
+ * @brief Resolves a requested worker count, where 0 means one per hardware thread.
+ * @param requested The requested number of threads.
+ * @return The number of threads to use, always at least 1.
+ */
+inline u32 resolveThreadCount(u32 requested)
+{
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested == 0 ? 1 : requested;
+}
+
+/**
+ * @brief Splits [0, count) into contiguous chunks and processes them on worker threads.
+ *
+ * The calling thread processes the last chunk itself, so a thread count of 1 runs inline
+ * without spawning anything.
+ *
+ * @param count Number of items to process.
+ * @param threadCount Number of threads to use, 0 for one per hardware thread.
+ * @param fn Callable invoked as fn(begin, end, chunkIndex).
+ *
+ * Example usage:
+ * @code
+ * qm::parallelFor(values.size(), 0, [&](std::size_t begin, std::size_t end, u32) {
+ *     for (std::size_t i = begin; i < end; ++i) {
+ *         values[i] *= 2.0f;
+ *     }
+ * });
+ * @endcode
+ */
+template <typename Fn>
+void parallelFor(std::size_t count, u32 threadCount, Fn &&fn)
+{
+    if (count == 0) {
+        return;
+    }
+
+    const std::size_t chunks =
+        std::min(static_cast<std::size_t>(resolveThreadCount(threadCount)), count);
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (std::size_t chunk = 0; chunk + 1 < chunks; ++chunk) {
+        const std::size_t begin = std::min(chunk * chunkSize, count);
+        const std::size_t end = std::min(begin + chunkSize, count);
+        workers.emplace_back([&fn, begin, end, chunk] { fn(begin, end, static_cast<u32>(chunk)); });
+    }
+
+    const std::size_t lastBegin = (chunks - 1) * chunkSize;
+    fn(std::min(lastBegin, count), count, static_cast<u32>(chunks - 1));
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+namespace detail {
+
+// One worker per chunk runs every pass: it counts its chunk's digits, waits while a single thread
+// turns all histograms into per-chunk write offsets (keeping the scatter stable), then scatters
+// its chunk and waits for the others before the next pass. The threads are started once per sort.
+template <bool HasValues, IsRadixKeyT K, typename V>
+void parallelRadixSortImpl(K *keys, K *keyScratch, V *values, V *valueScratch, std::size_t count,
+                           u32 threadCount)
+{
+    constexpr u32 passes = sizeof(K);
+    using Histogram = std::array<std::size_t, RadixBuckets>;
+
+    const std::size_t chunks = std::min(static_cast<std::size_t>(resolveThreadCount(threadCount)),
+                                        qm::max<std::size_t>(count / 65536, 1));
+    if (chunks <= 1) {
+        radixSortImpl<HasValues>(keys, keyScratch, values, valueScratch, count);
+        return;
+    }
+
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    auto chunkBegin = [&](std::size_t chunk) { return std::min(chunk * chunkSize, count); };
+
+    std::vector<Histogram> histograms(chunks);
+    K *srcKeys = keys;
+    K *dstKeys = keyScratch;
+    V *srcValues = values;
+    V *dstValues = valueScratch;
+
+    bool trivial = false;
+
+    // Bucket-major, chunk-minor prefix sum
+    auto computeOffsets = [&]() noexcept {
+        std::size_t sum = 0;
+        trivial = false;
+        for (u32 bucket = 0; bucket < RadixBuckets; ++bucket) {
+            std::size_t bucketTotal = 0;
+            for (Histogram &histogram : histograms) {
+                const std::size_t bucketCount = histogram[bucket];
+                histogram[bucket] = sum;
+                sum += bucketCount;
+                bucketTotal += bucketCount;
+            }
+            trivial = trivial || bucketTotal == count;
+        }
+    };
+    auto swapBuffers = [&]() noexcept {
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    };
+    std::barrier counted(static_cast<std::ptrdiff_t>(chunks), computeOffsets);
+    std::barrier scattered(static_cast<std::ptrdiff_t>(chunks), swapBuffers);
+
+    parallelFor(chunks, static_cast<u32>(chunks), [&](std::size_t chunk, std::size_t, u32) {
+        const std::size_t begin = chunkBegin(chunk);
+        const std::size_t end = chunkBegin(chunk + 1);
+        Histogram &histogram = histograms[chunk];
+        for (u32 pass = 0; pass < passes; ++pass) {
+            histogram.fill(0);
+            for (std::size_t i = begin; i < end; ++i) {
+                ++histogram[radixDigit(srcKeys[i], pass)];
+            }
+            counted.arrive_and_wait();
+            // Every worker sees the same flag, so they all skip the scatter barrier together
+            if (trivial) {
+                continue;
+            }
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::size_t target = histogram[radixDigit(srcKeys[i], pass)]++;
+                dstKeys[target] = srcKeys[i];
+                if constexpr (HasValues) {
+                    dstValues[target] = srcValues[i];
+                }
+            }
+            scattered.arrive_and_wait();
+        }
+    });
+
+    if (srcKeys != keys) {
+        std::copy(srcKeys, srcKeys + count, keys);
+        if constexpr (HasValues) {
+            std::copy(srcValues, srcValues + count, values);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Multithreaded version of radixSort for large key arrays.
+ *
+ * Small inputs fall back to the single-threaded sort.
+ *
+ * @tparam K The key type.
+ * @param keys The keys to sort.
+ * @param scratch Scratch buffer, at least as large as keys.
+ * @param threadCount Number of threads to use, 0 for one per hardware thread.
+ */
+template <IsRadixKeyT K>
+void parallelRadixSort(std::span<K> keys, std::span<K> scratch, u32 threadCount = 0)
+{
+    QM_ASSERT(scratch.size() >= keys.size());
+    if (keys.size() > 1) {
+        detail::parallelRadixSortImpl<false, K, K>(keys.data(), scratch.data(), nullptr, nullptr,
+                                                   keys.size(), threadCount);
+    }
+}
+
+/**
+ * @brief Multithreaded version of the key-value radixSort for large arrays.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type, moved along with its key.
+ * @param keys The keys to sort.
+ * @param values The values, one per key.
+ * @param keyScratch Scratch buffer, at least as large as keys.
+ * @param valueScratch Scratch buffer, at least as large as values.
+ * @param threadCount Number of threads to use, 0 for one per hardware thread.
+ */
+template <IsRadixKeyT K, typename V>
+void parallelRadixSort(std::span<K> keys, std::span<V> values, std::span<K> keyScratch,
+                       std::span<V> valueScratch, u32 threadCount = 0)
+{
+    QM_ASSERT(values.size() >= keys.size());
+    QM_ASSERT(keyScratch.size() >= keys.size() && valueScratch.size() >= keys.size());
+    if (keys.size() > 1) {
+        detail::parallelRadixSortImpl<true>(keys.data(), keyScratch.data(), values.data(),
+                                            valueScratch.data(), keys.size(), threadCount);
+    }
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_PARALLEL_HPP
@@ -0,0 +1,965 @@
+#ifndef QUIKMAFF_POLYGON_HPP
+#define QUIKMAFF_POLYGON_HPP
+
+#include <algorithm>
+#include <deque>
+#include <memory_resource>
+#include <queue>
+#include <set>
+#include <span>
+#include <vector>
+
+#include "arena.hpp"
+#include "predicates.hpp"
+#include "rect.hpp"
+#include "vec2.hpp"
+
+namespace qm {
+
+/**
+ * @brief Clips a polygon against a rectangle with the Sutherland-Hodgman algorithm.
+ *
+ * The polygon may be concave, in which case parts that leave and re-enter the rectangle stay
+ * connected by edges running along its border. Polygons entirely inside or entirely outside the
+ * rectangle's bounds are handled without clipping.
+ *
+ * @param polygon The polygon's vertices, in either winding order.
+ * @param rect The clip rectangle.
+ * @param arena The arena the result, and the intermediate clip stages, are allocated from.
+ * @return The clipped polygon with the input's winding order, empty if nothing is left. It
+ * stays valid until the arena is reset.
+ *
+ * Example usage:
+ * @code
+ * qm::Arena arena;
+ * std::span<vec2<f32>> visible = qm::clipPolygon(shape, scissor, arena);
+ * @endcode
+ */
+inline std::span<vec2<f32>> clipPolygon(std::span<const vec2<f32>> polygon, const Rect &rect,
+                                        Arena &arena)
+{
+    if (polygon.size() < 3) {
+        return {};
+    }
+
+    vec2<f32> lo = polygon[0];
+    vec2<f32> hi = polygon[0];
+    for (const vec2<f32> &p : polygon) {
+        lo = vec2<f32>(qm::min(lo.x, p.x), qm::min(lo.y, p.y));
+        hi = vec2<f32>(qm::max(hi.x, p.x), qm::max(hi.y, p.y));
+    }
+    if (hi.x < rect.left() || lo.x > rect.right() || hi.y < rect.bottom() || lo.y > rect.top()) {
+        return {};
+    }
+    if (lo.x >= rect.left() && hi.x <= rect.right() && lo.y >= rect.bottom() &&
+        hi.y <= rect.top()) {
+        std::span<vec2<f32>> result = arena.allocateArray<vec2<f32>>(polygon.size());
+        std::copy(polygon.begin(), polygon.end(), result.begin());
+        return result;
+    }
+
+    // One stage per rectangle side. A stage emits at most one vertex per edge plus one per exit,
+    // so its output is at most half as large again as its input
+    std::span<const vec2<f32>> input = polygon;
+    std::span<vec2<f32>> output;
+    for (u32 side = 0; side < 4; ++side) {
+        const bool vertical = side < 2;
+        const f32 bound = side == 0 ? rect.left()
+                          : side == 1 ? rect.right()
+                          : side == 2 ? rect.bottom()
+                                      : rect.top();
+        const bool keepAbove = side == 0 || side == 2;
+
+        auto inside = [&](const vec2<f32> &p) {
+            const f32 value = vertical ? p.x : p.y;
+            return keepAbove ? value >= bound : value <= bound;
+        };
+        auto crossing = [&](const vec2<f32> &a, const vec2<f32> &b) {
+            if (vertical) {
+                const f32 t = (bound - a.x) / (b.x - a.x);
+                return vec2<f32>(bound, a.y + (b.y - a.y) * t);
+            }
+            const f32 t = (bound - a.y) / (b.y - a.y);
+            return vec2<f32>(a.x + (b.x - a.x) * t, bound);
+        };
+
+        output = arena.allocateArray<vec2<f32>>(input.size() + input.size() / 2 + 1);
+        std::size_t count = 0;
+        vec2<f32> previous = input.back();
+        bool previousInside = inside(previous);
+        for (const vec2<f32> &current : input) {
+            const bool currentInside = inside(current);
+            if (currentInside != previousInside) {
+                output[count++] = crossing(previous, current);
+            }
+            if (currentInside) {
+                output[count++] = current;
+            }
+            previous = current;
+            previousInside = currentInside;
+        }
+
+        output = output.first(count);
+        if (count == 0) {
+            return {};
+        }
+        input = output;
+    }
+    return output;
+}
+
+/**
+ * @brief The operations supported by polygonBoolean.
+ */
+enum class BooleanOperation : u8 {
+    Intersection, ///< Area covered by both polygons
+    Union,        ///< Area covered by either polygon
+    Difference,   ///< Area covered by the subject but not the clip polygon
+    Xor           ///< Area covered by exactly one of the polygons
+};
+
+/**
+ * @brief A non-owning view of a polygon made of one or more contours stored back to back.
+ */
+struct PolygonView {
+    std::span<const vec2<f32>> points; ///< Vertices of every contour
+    /// Start offset of each contour into points, followed by points.size(); empty when the
+    /// polygon is a single contour
+    std::span<const u32> contourOffsets;
+
+    PolygonView() = default;
+
+    /**
+     * @brief Views a single contour as a polygon.
+     */
+    PolygonView(std::span<const vec2<f32>> contour) : points{contour} {}
+
+    /**
+     * @brief Views several contours as a polygon.
+     */
+    PolygonView(std::span<const vec2<f32>> points_, std::span<const u32> contourOffsets_)
+        : points{points_}, contourOffsets{contourOffsets_}
+    {
+    }
+
+    /**
+     * @brief Returns the number of contours.
+     */
+    std::size_t contourCount() const
+    {
+        if (contourOffsets.empty()) {
+            return points.empty() ? 0 : 1;
+        }
+        return contourOffsets.size() - 1;
+    }
+
+    /**
+     * @brief Returns the vertices of a contour.
+     */
+    std::span<const vec2<f32>> contour(std::size_t index) const
+    {
+        if (contourOffsets.empty()) {
+            return points;
+        }
+        return points.subspan(contourOffsets[index],
+                              contourOffsets[index + 1] - contourOffsets[index]);
+    }
+};
+
+/**
+ * @brief A polygon made of one or more contours, allocated from a memory resource.
+ *
+ * Polygons produced by polygonBoolean have counter-clockwise outer contours and clockwise holes.
+ */
+struct Polygon {
+    std::pmr::vector<vec2<f32>> points; ///< Vertices of every contour
+    /// Start offset of each contour into points, followed by points.size()
+    std::pmr::vector<u32> contourOffsets;
+
+    explicit Polygon(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : points{resource}, contourOffsets{resource}
+    {
+    }
+
+    /**
+     * @brief Returns the number of contours.
+     */
+    std::size_t contourCount() const
+    {
+        return contourOffsets.empty() ? 0 : contourOffsets.size() - 1;
+    }
+
+    /**
+     * @brief Returns the vertices of a contour.
+     */
+    std::span<const vec2<f32>> contour(std::size_t index) const
+    {
+        return std::span<const vec2<f32>>(points).subspan(
+            contourOffsets[index], contourOffsets[index + 1] - contourOffsets[index]);
+    }
+
+    operator PolygonView() const
+    {
+        if (contourOffsets.empty()) {
+            return PolygonView();
+        }
+        return PolygonView(points, contourOffsets);
+    }
+};
+
+namespace detail {
+
+// The input edge an event's edge was split from. Orientation tests run against it rather than
+// the rounded split points, so pieces of one edge stay exactly collinear.
+struct EdgeLine {
+    f64 X0; // Left end, by x then y
+    f64 Y0;
+    f64 X1;
+    f64 Y1;
+};
+
+struct SweepEvent;
+
+struct SegmentLess {
+    bool operator()(const SweepEvent *a, const SweepEvent *b) const;
+};
+
+using SweepLine = std::pmr::set<SweepEvent *, SegmentLess>;
+
+// An endpoint of a polygon edge. Every edge has a left and a right event, processed in order
+// of x as the sweep line moves across the plane.
+struct SweepEvent {
+    f64 X;
+    f64 Y;
+    const EdgeLine *Line;         // The input edge this edge lies on
+    SweepEvent *Other;            // The event at the other end of the edge
+    SweepLine::iterator Position; // Position on the sweep line, while InSweepLine
+    u32 ContourId;
+    u32 OtherPos;
+    i8 ResultTransition; // +1 if the result is entered crossing the edge upwards, -1 if left
+    bool Left;
+    bool IsSubject;
+    bool InOut;      // The edge is an inside-outside transition of its own polygon going up
+    bool OtherInOut; // The closest edge of the other polygon below is an inside-outside one
+    bool BelowInResult; // The result covers the region below the edge, or below its stack of
+                        // coincident edges
+    bool InSweepLine;
+};
+
+inline bool samePoint(const SweepEvent *a, const SweepEvent *b)
+{
+    return a->X == b->X && a->Y == b->Y;
+}
+
+inline bool isVertical(const SweepEvent *e) { return e->Line->X0 == e->Line->X1; }
+
+// Positive if a point is above a line, negative if below.
+inline f64 lineSide(const EdgeLine *line, f64 px, f64 py)
+{
+    return orient2d(line->X0, line->Y0, line->X1, line->Y1, px, py);
+}
+
+// Positive if line b turns counter-clockwise from line a.
+inline f64 lineTurn(const EdgeLine *a, const EdgeLine *b)
+{
+    return orient2d(0.0, 0.0, a->X1 - a->X0, a->Y1 - a->Y0, b->X1 - b->X0, b->Y1 - b->Y0);
+}
+
+inline bool collinear(const EdgeLine *a, const EdgeLine *b)
+{
+    return a == b || (lineSide(a, b->X0, b->Y0) == 0.0 && lineSide(a, b->X1, b->Y1) == 0.0);
+}
+
+// Whether the edge of an event passes below a point.
+inline bool edgeBelow(const SweepEvent *e, f64 px, f64 py)
+{
+    return lineSide(e->Line, px, py) > 0.0;
+}
+
+// Sweep order: by x then y; at a shared point right events come first, then lower edges.
+inline bool eventAfter(const SweepEvent *a, const SweepEvent *b)
+{
+    if (a->X != b->X) {
+        return a->X > b->X;
+    }
+    if (a->Y != b->Y) {
+        return a->Y > b->Y;
+    }
+    if (a->Left != b->Left) {
+        return a->Left;
+    }
+    if (!collinear(a->Line, b->Line)) {
+        // Edges leaving the point to the right are lower the more clockwise they turn, edges
+        // arriving from the left the more counter-clockwise
+        const f64 turn = lineTurn(a->Line, b->Line);
+        return a->Left ? turn < 0.0 : turn > 0.0;
+    }
+    // Coincident edges join the sweep line bottom first, in SegmentLess order
+    if (a->IsSubject != b->IsSubject) {
+        return b->IsSubject;
+    }
+    if (a->ContourId != b->ContourId) {
+        return a->ContourId > b->ContourId;
+    }
+    return std::less<const SweepEvent *>()(b, a);
+}
+
+struct EventAfter {
+    bool operator()(const SweepEvent *a, const SweepEvent *b) const { return eventAfter(a, b); }
+};
+
+// Vertical order of two edges on the sweep line.
+inline bool SegmentLess::operator()(const SweepEvent *a, const SweepEvent *b) const
+{
+    if (a == b) {
+        return false;
+    }
+
+    if (!collinear(a->Line, b->Line)) {
+        if (samePoint(a, b)) {
+            return lineTurn(a->Line, b->Line) > 0.0;
+        }
+        if (a->X == b->X) {
+            return a->Y < b->Y;
+        }
+        // Compare against whichever edge joined the sweep line first, by direction if the
+        // later edge starts on it
+        if (eventAfter(a, b)) {
+            const f64 side = lineSide(b->Line, a->X, a->Y);
+            return side != 0.0 ? side < 0.0 : lineTurn(b->Line, a->Line) < 0.0;
+        }
+        const f64 side = lineSide(a->Line, b->X, b->Y);
+        return side != 0.0 ? side > 0.0 : lineTurn(a->Line, b->Line) > 0.0;
+    }
+
+    // Collinear edges
+    if (a->IsSubject != b->IsSubject) {
+        return a->IsSubject;
+    }
+    if (samePoint(a, b)) {
+        if (a->ContourId != b->ContourId) {
+            return a->ContourId < b->ContourId;
+        }
+        return std::less<const SweepEvent *>()(a, b);
+    }
+    return !eventAfter(a, b);
+}
+
+// Intersection of the edges of two left events, classified with exact predicates against their
+// input edges: returns 0 for none, 1 for a single point and 2 for a collinear overlap, with the
+// points in out.
+inline u32 edgeIntersection(const SweepEvent *a, const SweepEvent *b, f64 (&out)[2][2])
+{
+    const f64 a1[2] = {a->X, a->Y};
+    const f64 a2[2] = {a->Other->X, a->Other->Y};
+    const f64 b1[2] = {b->X, b->Y};
+    const f64 b2[2] = {b->Other->X, b->Other->Y};
+    auto set = [&](u32 index, const f64 *p) {
+        out[index][0] = p[0];
+        out[index][1] = p[1];
+    };
+
+    if (collinear(a->Line, b->Line)) {
+        // Compare positions along the dominant axis, where equal means identical
+        const u32 axis = qm::abs(a2[0] - a1[0]) >= qm::abs(a2[1] - a1[1]) ? 0 : 1;
+        const f64 *aMin = a1[axis] <= a2[axis] ? a1 : a2;
+        const f64 *aMax = a1[axis] <= a2[axis] ? a2 : a1;
+        const f64 *bMin = b1[axis] <= b2[axis] ? b1 : b2;
+        const f64 *bMax = b1[axis] <= b2[axis] ? b2 : b1;
+        const f64 *lo = aMin[axis] >= bMin[axis] ? aMin : bMin;
+        const f64 *hi = aMax[axis] <= bMax[axis] ? aMax : bMax;
+        if (lo[axis] > hi[axis]) {
+            return 0;
+        }
+        set(0, lo);
+        if (lo[axis] == hi[axis]) {
+            return 1;
+        }
+        set(1, hi);
+        return 2;
+    }
+
+    const f64 o1 = lineSide(a->Line, b1[0], b1[1]);
+    const f64 o2 = lineSide(a->Line, b2[0], b2[1]);
+    const f64 o3 = lineSide(b->Line, a1[0], a1[1]);
+    const f64 o4 = lineSide(b->Line, a2[0], a2[1]);
+    if ((o1 > 0.0 && o2 > 0.0) || (o1 < 0.0 && o2 < 0.0) || (o3 > 0.0 && o4 > 0.0) ||
+        (o3 < 0.0 && o4 < 0.0)) {
+        return 0;
+    }
+
+    // Touching at an endpoint is exact
+    if (o1 == 0.0) {
+        set(0, b1);
+        return 1;
+    }
+    if (o2 == 0.0) {
+        set(0, b2);
+        return 1;
+    }
+    if (o3 == 0.0) {
+        set(0, a1);
+        return 1;
+    }
+    if (o4 == 0.0) {
+        set(0, a2);
+        return 1;
+    }
+
+    // A proper crossing is the correctly rounded intersection of the input edges' lines, so every
+    // pair of edges through one point agrees on it exactly, kept inside both edges' bounds
+    const EdgeLine *la = a->Line;
+    const EdgeLine *lb = b->Line;
+    const Difference va[2] = {exactDifference(la->X1, la->X0), exactDifference(la->Y1, la->Y0)};
+    const Difference vb[2] = {exactDifference(lb->X1, lb->X0), exactDifference(lb->Y1, lb->Y0)};
+    const Difference e[2] = {exactDifference(lb->X0, la->X0), exactDifference(lb->Y0, la->Y0)};
+    const f64 origin[2] = {la->X0, la->Y0};
+
+    // The crossing is origin + va * (e x vb) / (va x vb)
+    f64 denominator[16], factor[16];
+    const int denominatorLength = crossExpansion(va[0], vb[1], va[1], vb[0], denominator);
+    const int factorLength = crossExpansion(e[0], vb[1], e[1], vb[0], factor);
+    f64 crossing[2];
+    for (u32 axis = 0; axis < 2; ++axis) {
+        f64 scaled[32], offset[64], scratch[64], numerator[96];
+        const int scaledLength =
+            scaleExpansion(denominator, denominatorLength, origin[axis], scaled);
+        const int offsetLength = multiplyExpansions(factor, factorLength, va[axis].Components,
+                                                    va[axis].Length, offset, scratch);
+        const int numeratorLength =
+            expansionSum(scaled, scaledLength, offset, offsetLength, numerator);
+        crossing[axis] =
+            roundedQuotient(numerator, numeratorLength, denominator, denominatorLength);
+    }
+    for (u32 axis = 0; axis < 2; ++axis) {
+        const f64 lo = qm::max(qm::min(a1[axis], a2[axis]), qm::min(b1[axis], b2[axis]));
+        const f64 hi = qm::min(qm::max(a1[axis], a2[axis]), qm::max(b1[axis], b2[axis]));
+        out[0][axis] = qm::clamp(crossing[axis], lo, hi);
+    }
+    return 1;
+}
+
+// The Martinez-Rueda-Feito sweep: edges are split at every intersection, labelled as inside or
+// outside the other polygon, and those bounding the result are chained back into contours.
+class PolygonBoolean {
+public:
+    PolygonBoolean(BooleanOperation operation, std::pmr::memory_resource *resource)
+        : m_operation{operation},
+          m_resource{resource},
+          m_lines{resource},
+          m_events{resource},
+          m_queue{EventAfter{}, std::pmr::vector<SweepEvent *>(resource)},
+          m_sweepLine{resource},
+          m_sorted{resource}
+    {
+    }
+
+    void addPolygon(const PolygonView &polygon, bool isSubject, f64 (&bounds)[4])
+    {
+        for (std::size_t c = 0; c < polygon.contourCount(); ++c) {
+            const std::span<const vec2<f32>> contour = polygon.contour(c);
+            const u32 contourId = m_contourCount++;
+            for (std::size_t k = 0; k < contour.size(); ++k) {
+                const vec2<f32> &a = contour[k];
+                const vec2<f32> &b = contour[(k + 1) % contour.size()];
+                bounds[0] = qm::min(bounds[0], static_cast<f64>(a.x));
+                bounds[1] = qm::min(bounds[1], static_cast<f64>(a.y));
+                bounds[2] = qm::max(bounds[2], static_cast<f64>(a.x));
+                bounds[3] = qm::max(bounds[3], static_cast<f64>(a.y));
+                if (a.x == b.x && a.y == b.y) {
+                    continue;
+                }
+
+                const bool forward = a.x < b.x || (a.x == b.x && a.y < b.y);
+                const vec2<f32> &left = forward ? a : b;
+                const vec2<f32> &right = forward ? b : a;
+                const EdgeLine *line =
+                    &m_lines.emplace_back(EdgeLine{left.x, left.y, right.x, right.y});
+                SweepEvent *e1 = createEvent(a.x, a.y, false, isSubject, contourId, line);
+                SweepEvent *e2 = createEvent(b.x, b.y, false, isSubject, contourId, line);
+                e1->Other = e2;
+                e2->Other = e1;
+                if (eventAfter(e1, e2)) {
+                    e2->Left = true;
+                }
+                else {
+                    e1->Left = true;
+                }
+                m_queue.push(e1);
+                m_queue.push(e2);
+            }
+        }
+    }
+
+    void run(f64 subjectMaxX, f64 clipMaxX)
+    {
+        // Beyond the subject's extent nothing more can be in an intersection or difference
+        const f64 rightBound = m_operation == BooleanOperation::Intersection
+                                   ? qm::min(subjectMaxX, clipMaxX)
+                                   : subjectMaxX;
+        const bool bounded = m_operation == BooleanOperation::Intersection ||
+                             m_operation == BooleanOperation::Difference;
+
+        while (!m_queue.empty()) {
+            SweepEvent *event = m_queue.top();
+            m_queue.pop();
+            m_sorted.push_back(event);
+            m_current = event;
+
+            if (bounded && event->X > rightBound) {
+                break;
+            }
+
+            if (event->Left) {
+                const auto position = m_sweepLine.insert(event).first;
+                event->Position = position;
+                event->InSweepLine = true;
+
+                SweepEvent *prev = position == m_sweepLine.begin() ? nullptr : *std::prev(position);
+                const auto nextPosition = std::next(position);
+                SweepEvent *next = nextPosition == m_sweepLine.end() ? nullptr : *nextPosition;
+
+                computeFields(event, prev);
+                if (next != nullptr && possibleIntersection(event, next) == 2) {
+                    computeFields(event, prev);
+                    computeFields(next, event);
+                }
+                if (prev != nullptr && possibleIntersection(prev, event) == 2) {
+                    const auto prevPosition = prev->Position;
+                    SweepEvent *prevPrev = prevPosition == m_sweepLine.begin()
+                                               ? nullptr
+                                               : *std::prev(prevPosition);
+                    computeFields(prev, prevPrev);
+                    computeFields(event, prev);
+                }
+
+                // An edge split at this point gained a right event that belongs before this one;
+                // process that first, then label this edge again
+                if (m_splitAtCurrent) {
+                    m_splitAtCurrent = false;
+                    m_sweepLine.erase(position);
+                    event->InSweepLine = false;
+                    m_sorted.pop_back();
+                    m_queue.push(event);
+                }
+            }
+            else {
+                SweepEvent *left = event->Other;
+                if (!left->InSweepLine) {
+                    continue;
+                }
+                const auto position = left->Position;
+                SweepEvent *prev = position == m_sweepLine.begin() ? nullptr : *std::prev(position);
+                const auto nextPosition = std::next(position);
+                SweepEvent *next = nextPosition == m_sweepLine.end() ? nullptr : *nextPosition;
+
+                m_sweepLine.erase(position);
+                left->InSweepLine = false;
+                if (prev != nullptr && next != nullptr) {
+                    possibleIntersection(prev, next);
+                }
+            }
+        }
+    }
+
+    void connectEdges(Polygon &result)
+    {
+        // Events of the result edges, in sweep order; overlapping edges can leave the order
+        // slightly off, which an insertion sort repairs cheaply
+        std::pmr::vector<SweepEvent *> events(m_resource);
+        for (SweepEvent *e : m_sorted) {
+            if ((e->Left && e->ResultTransition != 0) ||
+                (!e->Left && e->Other->ResultTransition != 0)) {
+                events.push_back(e);
+            }
+        }
+        for (std::size_t i = 1; i < events.size(); ++i) {
+            SweepEvent *e = events[i];
+            std::size_t j = i;
+            while (j > 0 && eventAfter(events[j - 1], e)) {
+                events[j] = events[j - 1];
+                --j;
+            }
+            events[j] = e;
+        }
+
+        // Point every event at the position of its partner
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            events[i]->OtherPos = static_cast<u32>(i);
+        }
+        for (SweepEvent *e : events) {
+            if (!e->Left) {
+                std::swap(e->OtherPos, e->Other->OtherPos);
+            }
+        }
+
+        std::pmr::vector<u8> processed(events.size(), 0, m_resource);
+        const i64 size = static_cast<i64>(events.size());
+        for (i64 i = 0; i < size; ++i) {
+            if (processed[i]) {
+                continue;
+            }
+
+            // Walk the boundary keeping the result on the same side as along the first edge,
+            // which is the lowest one leaving the contour's leftmost point. With the result on
+            // the left, outer boundaries come out counter-clockwise and holes clockwise.
+            const std::size_t start = result.points.size();
+            const bool resultOnLeft = events[i]->ResultTransition > 0;
+            i64 pos = i;
+            result.points.emplace_back(events[i]->X, events[i]->Y);
+            while (true) {
+                processed[pos] = 1;
+                const SweepEvent *from = events[pos];
+                pos = events[pos]->OtherPos;
+                processed[pos] = 1;
+
+                pos = nextEdge(pos, from, events, processed, i, resultOnLeft);
+                if (pos == i || pos < 0) {
+                    break;
+                }
+                result.points.emplace_back(events[pos]->X, events[pos]->Y);
+            }
+            finishContour(result, start, !resultOnLeft);
+        }
+    }
+
+private:
+    SweepEvent *createEvent(f64 x, f64 y, bool left, bool isSubject, u32 contourId,
+                            const EdgeLine *line)
+    {
+        SweepEvent &e = m_events.emplace_back();
+        e.X = x;
+        e.Y = y;
+        e.Line = line;
+        e.Other = nullptr;
+        e.ContourId = contourId;
+        e.OtherPos = 0;
+        e.ResultTransition = 0;
+        e.BelowInResult = false;
+        e.Left = left;
+        e.IsSubject = isSubject;
+        e.InOut = false;
+        e.OtherInOut = false;
+        e.InSweepLine = false;
+        return &e;
+    }
+
+    bool insideResult(bool inSubject, bool inClip) const
+    {
+        switch (m_operation) {
+        case BooleanOperation::Intersection:
+            return inSubject && inClip;
+        case BooleanOperation::Union:
+            return inSubject || inClip;
+        case BooleanOperation::Difference:
+            return inSubject && !inClip;
+        case BooleanOperation::Xor:
+            return inSubject != inClip;
+        }
+        return false;
+    }
+
+    // Whether the result covers the region just above or below an edge, given whether that
+    // region is inside the edge's own polygon.
+    bool resultSide(const SweepEvent *e, bool inOwn) const
+    {
+        const bool inOther = !e->OtherInOut;
+        return e->IsSubject ? insideResult(inOwn, inOther) : insideResult(inOther, inOwn);
+    }
+
+    // Labels an edge from the closest edge below it on the sweep line.
+    void computeFields(SweepEvent *e, SweepEvent *prev)
+    {
+        const bool coincident =
+            prev != nullptr && samePoint(e, prev) && samePoint(e->Other, prev->Other);
+
+        if (prev == nullptr) {
+            e->InOut = false;
+            e->OtherInOut = true;
+        }
+        else {
+            if (e->IsSubject == prev->IsSubject) {
+                e->InOut = !prev->InOut;
+                e->OtherInOut = prev->OtherInOut;
+            }
+            else {
+                e->InOut = !prev->OtherInOut;
+                e->OtherInOut = isVertical(prev) && !coincident ? !prev->InOut : prev->InOut;
+            }
+        }
+
+        // Of a stack of coincident edges only the top one can bound the result, comparing the
+        // regions above and below the whole stack
+        if (coincident) {
+            e->BelowInResult = prev->BelowInResult;
+            prev->ResultTransition = 0;
+        }
+        else {
+            e->BelowInResult = resultSide(e, e->InOut);
+        }
+        const bool aboveInResult = resultSide(e, !e->InOut);
+        e->ResultTransition = aboveInResult == e->BelowInResult ? 0 : aboveInResult ? 1 : -1;
+    }
+
+    // Splits the edge of a left event at a point on it.
+    void divideSegment(SweepEvent *se, f64 x, f64 y)
+    {
+        if (m_current->Left && x == m_current->X && y == m_current->Y) {
+            m_splitAtCurrent = true;
+        }
+
+        SweepEvent *r = createEvent(x, y, false, se->IsSubject, se->ContourId, se->Line);
+        SweepEvent *l = createEvent(x, y, true, se->IsSubject, se->ContourId, se->Line);
+        r->Other = se;
+        l->Other = se->Other;
+
+        // Rounding can put the split point past the right end
+        if (eventAfter(l, se->Other)) {
+            se->Other->Left = true;
+            l->Left = false;
+        }
+
+        se->Other->Other = l;
+        se->Other = r;
+        m_queue.push(l);
+        m_queue.push(r);
+    }
+
+    // Splits an edge along with any coincident copies, which sit next to it on the sweep line
+    // and would otherwise be split late, out of sweep order.
+    void divideCoincident(SweepEvent *se, f64 x, f64 y)
+    {
+        auto sameEdge = [se](const SweepEvent *e) {
+            return samePoint(e, se) && samePoint(e->Other, se->Other);
+        };
+        if (se->InSweepLine) {
+            for (auto it = se->Position; it != m_sweepLine.begin();) {
+                --it;
+                if (!sameEdge(*it)) {
+                    break;
+                }
+                divideSegment(*it, x, y);
+            }
+            for (auto it = std::next(se->Position); it != m_sweepLine.end() && sameEdge(*it);
+                 ++it) {
+                divideSegment(*it, x, y);
+            }
+        }
+        divideSegment(se, x, y);
+    }
+
+    // Splits two neighbouring edges where they intersect. Returns 2 when they overlap with a
+    // shared left endpoint, in which case their labels need recomputing.
+    int possibleIntersection(SweepEvent *se1, SweepEvent *se2)
+    {
+        f64 points[2][2];
+        const u32 count = edgeIntersection(se1, se2, points);
+
+        if (count == 0) {
+            return 0;
+        }
+        if (count == 1 && (samePoint(se1, se2) || samePoint(se1->Other, se2->Other))) {
+            return 0;
+        }
+
+        if (count == 1) {
+            const f64 x = points[0][0];
+            const f64 y = points[0][1];
+            auto isEndpoint = [x, y](const SweepEvent *e) {
+                return (e->X == x && e->Y == y) || (e->Other->X == x && e->Other->Y == y);
+            };
+            if (!isEndpoint(se1)) {
+                divideCoincident(se1, x, y);
+            }
+            if (!isEndpoint(se2)) {
+                divideCoincident(se2, x, y);
+            }
+            return 1;
+        }
+
+        // The edges overlap
+        SweepEvent *events[4];
+        u32 eventCount = 0;
+        const bool leftCoincide = samePoint(se1, se2);
+        const bool rightCoincide = samePoint(se1->Other, se2->Other);
+        if (!leftCoincide) {
+            if (eventAfter(se1, se2)) {
+                events[eventCount++] = se2;
+                events[eventCount++] = se1;
+            }
+            else {
+                events[eventCount++] = se1;
+                events[eventCount++] = se2;
+            }
+        }
+        if (!rightCoincide) {
+            if (eventAfter(se1->Other, se2->Other)) {
+                events[eventCount++] = se2->Other;
+                events[eventCount++] = se1->Other;
+            }
+            else {
+                events[eventCount++] = se1->Other;
+                events[eventCount++] = se2->Other;
+            }
+        }
+
+        if (leftCoincide) {
+            // Both edges are equal or share the left endpoint; the caller relabels them
+            if (!rightCoincide) {
+                divideCoincident(events[1]->Other, events[0]->X, events[0]->Y);
+            }
+            return 2;
+        }
+
+        if (rightCoincide) {
+            divideCoincident(events[0], events[1]->X, events[1]->Y);
+            return 3;
+        }
+
+        if (events[0] != events[3]->Other) {
+            // Neither edge contains the other
+            divideCoincident(events[0], events[1]->X, events[1]->Y);
+            divideCoincident(events[1], events[2]->X, events[2]->Y);
+            return 3;
+        }
+
+        // One edge contains the other
+        divideCoincident(events[0], events[1]->X, events[1]->Y);
+        divideCoincident(events[3]->Other, events[2]->X, events[2]->Y);
+        return 3;
+    }
+
+    // Picks the edge to continue along after arriving at an event's point from another point.
+    // Where several result edges meet, the sharpest turn towards the result's side keeps
+    // regions touching at a vertex in separate contours. Returns origin to close the contour,
+    // or -1 if the boundary is open.
+    static i64 nextEdge(i64 pos, const SweepEvent *from,
+                        const std::pmr::vector<SweepEvent *> &events,
+                        const std::pmr::vector<u8> &processed, i64 origin, bool resultOnLeft)
+    {
+        const i64 size = static_cast<i64>(events.size());
+        const f64 x = events[pos]->X;
+        const f64 y = events[pos]->Y;
+        i64 first = pos;
+        while (first > 0 && events[first - 1]->X == x && events[first - 1]->Y == y) {
+            --first;
+        }
+
+        // Clockwise angle from the way back, ordered as 0 < (0, pi) < pi < (pi, 2pi) < 2pi,
+        // mirrored when the result is on the right
+        const f64 sign = resultOnLeft ? 1.0 : -1.0;
+        auto sector = [&](const SweepEvent *e) {
+            const f64 side = sign * orient2d(x, y, from->X, from->Y, e->Other->X, e->Other->Y);
+            if (side < 0.0) {
+                return 0;
+            }
+            if (side > 0.0) {
+                return 2;
+            }
+            const f64 dot = (from->X - x) * (e->Other->X - x) + (from->Y - y) * (e->Other->Y - y);
+            return dot < 0.0 ? 1 : 3;
+        };
+
+        i64 best = -1;
+        int bestSector = 0;
+        for (i64 k = first; k < size && events[k]->X == x && events[k]->Y == y; ++k) {
+            if (processed[k] && k != origin) {
+                continue;
+            }
+            const int candidateSector = sector(events[k]);
+            if (best < 0 || candidateSector < bestSector ||
+                (candidateSector == bestSector &&
+                 sign * orient2d(x, y, events[best]->Other->X, events[best]->Other->Y,
+                                 events[k]->Other->X, events[k]->Other->Y) > 0.0)) {
+                best = k;
+                bestSector = candidateSector;
+            }
+        }
+        return best;
+    }
+
+    // Closes the contour started at start, dropping it if degenerate.
+    static void finishContour(Polygon &result, std::size_t start, bool reverse)
+    {
+        std::pmr::vector<vec2<f32>> &points = result.points;
+        if (points.size() - start < 3) {
+            points.resize(start);
+            return;
+        }
+        if (reverse) {
+            std::reverse(points.begin() + static_cast<std::ptrdiff_t>(start), points.end());
+        }
+
+        if (result.contourOffsets.empty()) {
+            result.contourOffsets.push_back(0);
+        }
+        result.contourOffsets.push_back(static_cast<u32>(points.size()));
+    }
+
+private:
+    BooleanOperation m_operation;
+    std::pmr::memory_resource *m_resource;
+    std::pmr::deque<EdgeLine> m_lines;
+    std::pmr::deque<SweepEvent> m_events;
+    std::priority_queue<SweepEvent *, std::pmr::vector<SweepEvent *>, EventAfter> m_queue;
+    SweepLine m_sweepLine;
+    std::pmr::vector<SweepEvent *> m_sorted;
+    SweepEvent *m_current = nullptr;
+    bool m_splitAtCurrent = false;
+    u32 m_contourCount = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief Computes the union, intersection, difference or xor of two polygons.
+ *
+ * Uses the Martinez-Rueda-Feito sweep-line algorithm, which runs in O((n + k) log n) for n
+ * edges with k intersections. Polygons may have any number of contours, holes and
+ * self-intersections, in either winding order; a point is inside when a ray from it crosses
+ * the polygon's edges an odd number of times. Intersection points are rounded to f32 in the
+ * output.
+ *
+ * All working memory and the result are allocated from the given resource. With an Arena,
+ * repeated operations stop allocating once the arena has grown, and everything is released
+ * together on reset.
+ *
+ * @param subject The subject polygon.
+ * @param clip The clip polygon.
+ * @param operation The operation to perform.
+ * @param resource The memory resource to allocate from.
+ * @return The result, with counter-clockwise outer contours and clockwise holes.
+ *
+ * Example usage:
+ * @code
+ * qm::Arena arena;
+ * qm::Polygon revealed = qm::polygonBoolean(explored, visionCone, qm::BooleanOperation::Union,
+ *                                           arena);
+ * @endcode
+ */
+inline Polygon polygonBoolean(const PolygonView &subject, const PolygonView &clip,
+                              BooleanOperation operation, std::pmr::memory_resource &resource)
+{
+    Polygon result(&resource);
+
+    detail::PolygonBoolean sweep(operation, &resource);
+    f64 subjectBounds[4] = {std::numeric_limits<f64>::max(), std::numeric_limits<f64>::max(),
+                            std::numeric_limits<f64>::lowest(), std::numeric_limits<f64>::lowest()};
+    f64 clipBounds[4] = {subjectBounds[0], subjectBounds[1], subjectBounds[2], subjectBounds[3]};
+    sweep.addPolygon(subject, true, subjectBounds);
+    sweep.addPolygon(clip, false, clipBounds);
+
+    const bool disjoint = subjectBounds[0] > clipBounds[2] || clipBounds[0] > subjectBounds[2] ||
+                          subjectBounds[1] > clipBounds[3] || clipBounds[1] > subjectBounds[3];
+    if (operation == BooleanOperation::Intersection && disjoint) {
+        return result;
+    }
+
+    sweep.run(subjectBounds[2], clipBounds[2]);
+    sweep.connectEdges(result);
+    return result;
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_POLYGON_HPP
@@ -0,0 +1,713 @@
+#ifndef QUIKMAFF_PREDICATES_HPP
+#define QUIKMAFF_PREDICATES_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+/**
+ * Robust geometric predicates.
+ *
+ * Each predicate first evaluates its determinant in plain double precision together with a
+ * bound on the rounding error (Shewchuk's error bounds). Only when the result is too close to
+ * zero for its sign to be trusted is it recomputed exactly with floating-point expansion
+ * arithmetic, so the sign is always correct while the common case costs a handful of flops.
+ * The exact stage adapts to its input as well: coordinate differences that are already exact,
+ * as they are for most float input, keep every intermediate expansion short.
+ *
+ * The exact stage depends on IEEE round-to-nearest double arithmetic: do not compile it with
+ * -ffast-math or anything else that lets the compiler reassociate floating-point expressions.
+ */
+
+namespace qm {
+
+namespace detail {
+
+constexpr f64 PredicateEpsilon = 0x1p-53;
+constexpr f64 Orient2dErrorBound = (3.0 + 16.0 * PredicateEpsilon) * PredicateEpsilon;
+constexpr f64 IncircleErrorBound = (10.0 + 96.0 * PredicateEpsilon) * PredicateEpsilon;
+constexpr f64 Orient3dErrorBound = (7.0 + 56.0 * PredicateEpsilon) * PredicateEpsilon;
+constexpr f64 InsphereErrorBound = (16.0 + 224.0 * PredicateEpsilon) * PredicateEpsilon;
+
+// x + y == a + b exactly, with x the rounded sum.
+inline void twoSum(f64 a, f64 b, f64 &x, f64 &y)
+{
+    x = a + b;
+    const f64 bVirtual = x - a;
+    const f64 aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+// As twoSum, valid only when |a| >= |b|.
+inline void fastTwoSum(f64 a, f64 b, f64 &x, f64 &y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+// x + y == a - b exactly, with x the rounded difference.
+inline void twoDiff(f64 a, f64 b, f64 &x, f64 &y)
+{
+    x = a - b;
+    const f64 bVirtual = a - x;
+    const f64 aVirtual = x + bVirtual;
+    y = (a - aVirtual) + (bVirtual - b);
+}
+
+// x + y == a * b exactly, with x the rounded product.
+inline void twoProduct(f64 a, f64 b, f64 &x, f64 &y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// Expansions are arrays of non-overlapping components in increasing order of magnitude whose
+// exact sum is the represented value. The functions below write their result to h, drop zero
+// components and return the result's length, which is never 0.
+
+// h = e + f
+inline int expansionSum(const f64 *e, int eLength, const f64 *f, int fLength, f64 *h)
+{
+    // Merge both inputs by magnitude, then sweep the running sum through them
+    int i = 0;
+    int j = 0;
+    auto next = [&]() {
+        if (j >= fLength || (i < eLength && std::abs(e[i]) < std::abs(f[j]))) {
+            return e[i++];
+        }
+        return f[j++];
+    };
+
+    int length = 0;
+    f64 q = next();
+    for (int k = 1; k < eLength + fLength; ++k) {
+        f64 sum, error;
+        twoSum(q, next(), sum, error);
+        if (error != 0.0) {
+            h[length++] = error;
+        }
+        q = sum;
+    }
+    if (q != 0.0 || length == 0) {
+        h[length++] = q;
+    }
+    return length;
+}
+
+// h = e * b
+inline int scaleExpansion(const f64 *e, int eLength, f64 b, f64 *h)
+{
+    int length = 0;
+    f64 q, error;
+    twoProduct(e[0], b, q, error);
+    if (error != 0.0) {
+        h[length++] = error;
+    }
+    for (int i = 1; i < eLength; ++i) {
+        f64 product, productError, sum;
+        twoProduct(e[i], b, product, productError);
+        twoSum(q, productError, sum, error);
+        if (error != 0.0) {
+            h[length++] = error;
+        }
+        fastTwoSum(product, sum, q, error);
+        if (error != 0.0) {
+            h[length++] = error;
+        }
+    }
+    if (q != 0.0 || length == 0) {
+        h[length++] = q;
+    }
+    return length;
+}
+
+// h = e * f, using scratch for partial products. h and scratch must hold 2 * eLength * fLength
+// components.
+inline int multiplyExpansions(const f64 *e, int eLength, const f64 *f, int fLength, f64 *h,
+                              f64 *scratch)
+{
+    f64 partial[64];
+    QM_ASSERT(2 * eLength <= 64);
+
+    int length = scaleExpansion(e, eLength, f[0], h);
+    for (int i = 1; i < fLength; ++i) {
+        const int partialLength = scaleExpansion(e, eLength, f[i], partial);
+        const int sumLength = expansionSum(h, length, partial, partialLength, scratch);
+        for (int k = 0; k < sumLength; ++k) {
+            h[k] = scratch[k];
+        }
+        length = sumLength;
+    }
+    return length;
+}
+
+inline void negateExpansion(f64 *e, int eLength)
+{
+    for (int i = 0; i < eLength; ++i) {
+        e[i] = -e[i];
+    }
+}
+
+// The largest component carries the sign of an expansion.
+inline f64 expansionEstimate(const f64 *e, int eLength) { return e[eLength - 1]; }
+
+// The double nearest to n / d, ties to even, for expansions of up to 96 and 16 components and a
+// nonzero d. Starting from the approximate quotient, the candidate is stepped one ulp at a time
+// until the exact sign of n - q * d brackets the true value.
+inline f64 roundedQuotient(const f64 *n, int nLength, const f64 *d, int dLength)
+{
+    f64 numerator[96], denominator[16];
+    std::copy(n, n + nLength, numerator);
+    std::copy(d, d + dLength, denominator);
+    if (expansionEstimate(denominator, dLength) < 0.0) {
+        negateExpansion(numerator, nLength);
+        negateExpansion(denominator, dLength);
+    }
+
+    f64 approximateN = 0.0;
+    f64 approximateD = 0.0;
+    for (int i = 0; i < nLength; ++i) {
+        approximateN += numerator[i];
+    }
+    for (int i = 0; i < dLength; ++i) {
+        approximateD += denominator[i];
+    }
+
+    // Sign of scale * n - (q + r) * d, which for d > 0 orders (q + r) / scale against n / d
+    auto compare = [&](f64 q, f64 r, f64 scale) {
+        f64 scaledN[192], productQ[32], productR[32], product[64], difference[256];
+        const int scaledLength = scaleExpansion(numerator, nLength, scale, scaledN);
+        int productLength = scaleExpansion(denominator, dLength, q, productQ);
+        if (r != 0.0) {
+            const int rLength = scaleExpansion(denominator, dLength, r, productR);
+            productLength = expansionSum(productQ, productLength, productR, rLength, product);
+        }
+        else {
+            std::copy(productQ, productQ + productLength, product);
+        }
+        negateExpansion(product, productLength);
+        const int length = expansionSum(scaledN, scaledLength, product, productLength, difference);
+        const f64 estimate = expansionEstimate(difference, length);
+        return estimate > 0.0 ? 1 : (estimate < 0.0 ? -1 : 0);
+    };
+
+    const f64 q = approximateN / approximateD;
+    int side = compare(q, 0.0, 1.0);
+    if (side == 0) {
+        return q;
+    }
+
+    // Walk towards the true quotient until it lies between inside and outside
+    const f64 direction = side > 0 ? HUGE_VAL : -HUGE_VAL;
+    f64 inside = q;
+    f64 outside = std::nextafter(q, direction);
+    while ((side = compare(outside, 0.0, 1.0)) * (direction > 0.0 ? 1 : -1) > 0) {
+        inside = outside;
+        outside = std::nextafter(outside, direction);
+    }
+    if (side == 0) {
+        return outside;
+    }
+
+    // Round to the nearer neighbour by the sign against their midpoint
+    const f64 lo = std::min(inside, outside);
+    const f64 hi = std::max(inside, outside);
+    const int half = compare(lo, hi, 2.0);
+    if (half != 0) {
+        return half > 0 ? hi : lo;
+    }
+    return (std::bit_cast<u64>(lo) & 1) == 0 ? lo : hi;
+}
+
+// An exact coordinate difference as an expansion of one or two components. Differences of
+// nearby coordinates, and of any two floats, are usually exact already, which keeps every
+// product built from them short.
+struct Difference {
+    f64 Components[2];
+    int Length;
+};
+
+inline Difference exactDifference(f64 a, f64 b)
+{
+    Difference d;
+    twoDiff(a, b, d.Components[1], d.Components[0]);
+    if (d.Components[0] == 0.0) {
+        d.Components[0] = d.Components[1];
+        d.Length = 1;
+    }
+    else {
+        d.Length = 2;
+    }
+    return d;
+}
+
+// h = p * q - r * s, with h holding up to 16 components.
+inline int crossExpansion(const Difference &p, const Difference &q, const Difference &r,
+                          const Difference &s, f64 *h)
+{
+    f64 scratch[8], left[8], right[8];
+    const int leftLength =
+        multiplyExpansions(p.Components, p.Length, q.Components, q.Length, left, scratch);
+    const int rightLength =
+        multiplyExpansions(r.Components, r.Length, s.Components, s.Length, right, scratch);
+    negateExpansion(right, rightLength);
+    return expansionSum(left, leftLength, right, rightLength, h);
+}
+
+inline f64 orient2dExact(f64 ax, f64 ay, f64 bx, f64 by, f64 cx, f64 cy)
+{
+    const Difference acx = exactDifference(ax, cx);
+    const Difference bcy = exactDifference(by, cy);
+    const Difference acy = exactDifference(ay, cy);
+    const Difference bcx = exactDifference(bx, cx);
+
+    f64 det[16];
+    const int length = crossExpansion(acx, bcy, acy, bcx, det);
+    return expansionEstimate(det, length);
+}
+
+// h = |p|^2 for a 2D or 3D difference vector, with h holding up to 24 components.
+inline int liftExpansion(const Difference *p, int dimensions, f64 *h)
+{
+    f64 scratch[24], square[8], sum[24];
+    int length = multiplyExpansions(p[0].Components, p[0].Length, p[0].Components, p[0].Length,
+                                    h, scratch);
+    for (int i = 1; i < dimensions; ++i) {
+        const int squareLength = multiplyExpansions(p[i].Components, p[i].Length, p[i].Components,
+                                                    p[i].Length, square, scratch);
+        length = expansionSum(h, length, square, squareLength, sum);
+        for (int k = 0; k < length; ++k) {
+            h[k] = sum[k];
+        }
+    }
+    return length;
+}
+
+inline f64 incircleExact(f64 ax, f64 ay, f64 bx, f64 by, f64 cx, f64 cy, f64 dx, f64 dy)
+{
+    const Difference ad[2] = {exactDifference(ax, dx), exactDifference(ay, dy)};
+    const Difference bd[2] = {exactDifference(bx, dx), exactDifference(by, dy)};
+    const Difference cd[2] = {exactDifference(cx, dx), exactDifference(cy, dy)};
+
+    // det = lift(a) * (b x c) + lift(b) * (c x a) + lift(c) * (a x b)
+    const Difference *rows[3] = {ad, bd, cd};
+    f64 terms[3][512];
+    int termLengths[3];
+    for (int i = 0; i < 3; ++i) {
+        const Difference *p = rows[i];
+        const Difference *q = rows[(i + 1) % 3];
+        const Difference *r = rows[(i + 2) % 3];
+
+        f64 lift[24], cross[16], scratch[512];
+        const int liftLength = liftExpansion(p, 2, lift);
+        const int crossLength = crossExpansion(q[0], r[1], r[0], q[1], cross);
+        termLengths[i] =
+            multiplyExpansions(lift, liftLength, cross, crossLength, terms[i], scratch);
+    }
+
+    f64 ab[1024], det[1536];
+    const int abLength = expansionSum(terms[0], termLengths[0], terms[1], termLengths[1], ab);
+    const int length = expansionSum(ab, abLength, terms[2], termLengths[2], det);
+    return expansionEstimate(det, length);
+}
+
+// h = p.z * (q x r).xy + q.z * (r x p).xy + r.z * (p x q).xy, the determinant of the 3x3 matrix
+// with rows p, q and r, with h holding up to 192 components.
+inline int determinantExpansion(const Difference *p, const Difference *q, const Difference *r,
+                                f64 *h)
+{
+    const Difference *rows[3] = {p, q, r};
+    f64 terms[3][64];
+    int termLengths[3];
+    for (int i = 0; i < 3; ++i) {
+        const Difference *a = rows[i];
+        const Difference *b = rows[(i + 1) % 3];
+        const Difference *c = rows[(i + 2) % 3];
+
+        f64 cross[16], scratch[64];
+        const int crossLength = crossExpansion(b[0], c[1], c[0], b[1], cross);
+        termLengths[i] =
+            multiplyExpansions(a[2].Components, a[2].Length, cross, crossLength, terms[i], scratch);
+    }
+
+    f64 ab[128];
+    const int abLength = expansionSum(terms[0], termLengths[0], terms[1], termLengths[1], ab);
+    return expansionSum(ab, abLength, terms[2], termLengths[2], h);
+}
+
+inline f64 orient3dExact(const f64 *a, const f64 *b, const f64 *c, const f64 *d)
+{
+    Difference ad[3], bd[3], cd[3];
+    for (int i = 0; i < 3; ++i) {
+        ad[i] = exactDifference(a[i], d[i]);
+        bd[i] = exactDifference(b[i], d[i]);
+        cd[i] = exactDifference(c[i], d[i]);
+    }
+
+    f64 det[192];
+    const int length = determinantExpansion(ad, bd, cd, det);
+    return expansionEstimate(det, length);
+}
+
+inline f64 insphereExact(const f64 *a, const f64 *b, const f64 *c, const f64 *d, const f64 *e)
+{
+    // The worst case runs to tens of thousands of components, far too many for the stack
+    struct Buffers {
+        std::vector<f64> Term = std::vector<f64>(9216);
+        std::vector<f64> Scratch = std::vector<f64>(9216);
+        std::vector<f64> Sum = std::vector<f64>(36864);
+        std::vector<f64> Next = std::vector<f64>(36864);
+    };
+    thread_local Buffers buffers;
+
+    Difference rows[4][3];
+    const f64 *points[4] = {a, b, c, d};
+    for (int i = 0; i < 4; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            rows[i][k] = exactDifference(points[i][k], e[k]);
+        }
+    }
+
+    // Cofactor expansion along the lift column, with alternating signs
+    int sumLength = 0;
+    for (int i = 0; i < 4; ++i) {
+        const Difference *p = rows[(i + 1) % 4];
+        const Difference *q = rows[(i + 2) % 4];
+        const Difference *r = rows[(i + 3) % 4];
+
+        f64 lift[24], minor[192];
+        const int liftLength = liftExpansion(rows[i], 3, lift);
+        const int minorLength = determinantExpansion(p, q, r, minor);
+        if (i % 2 == 0) {
+            negateExpansion(minor, minorLength);
+        }
+
+        const int termLength = multiplyExpansions(lift, liftLength, minor, minorLength,
+                                                  buffers.Term.data(), buffers.Scratch.data());
+        if (sumLength == 0) {
+            std::copy_n(buffers.Term.data(), termLength, buffers.Sum.data());
+            sumLength = termLength;
+        }
+        else {
+            sumLength = expansionSum(buffers.Sum.data(), sumLength, buffers.Term.data(),
+                                     termLength, buffers.Next.data());
+            std::swap(buffers.Sum, buffers.Next);
+        }
+    }
+    return expansionEstimate(buffers.Sum.data(), sumLength);
+}
+
+} // namespace detail
+
+/**
+ * @brief Orientation test for three 2D points.
+ * @param ax, ay The first point.
+ * @param bx, by The second point.
+ * @param cx, cy The third point.
+ * @return Positive if the points are in counter-clockwise order (c lies to the left of the
+ * directed line from a to b), negative if clockwise and zero if they are collinear. The sign is
+ * exact; the magnitude approximates twice the signed area of the triangle.
+ */
+inline f64 orient2d(f64 ax, f64 ay, f64 bx, f64 by, f64 cx, f64 cy)
+{
+    const f64 detLeft = (ax - cx) * (by - cy);
+    const f64 detRight = (ay - cy) * (bx - cx);
+    const f64 det = detLeft - detRight;
+
+    f64 detSum;
+    if (detLeft > 0.0) {
+        if (detRight <= 0.0) {
+            return det;
+        }
+        detSum = detLeft + detRight;
+    }
+    else if (detLeft < 0.0) {
+        if (detRight >= 0.0) {
+            return det;
+        }
+        detSum = -detLeft - detRight;
+    }
+    else {
+        return det;
+    }
+
+    const f64 errorBound = detail::Orient2dErrorBound * detSum;
+    if (det >= errorBound || -det >= errorBound) {
+        return det;
+    }
+    return detail::orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+/**
+ * @brief Orientation test for three 2D points.
+ * @param a The first point.
+ * @param b The second point.
+ * @param c The third point.
+ * @return Positive if counter-clockwise, negative if clockwise and zero if collinear.
+ *
+ * Example usage:
+ * @code
+ * if (qm::orient2d(edgeStart, edgeEnd, point) > 0.0) {
+ *     // point is on the left of the edge
+ * }
+ * @endcode
+ */
+template <IsFloatingPointT T>
+f64 orient2d(const vec2<T> &a, const vec2<T> &b, const vec2<T> &c)
+{
+    return orient2d(static_cast<f64>(a.x), static_cast<f64>(a.y), static_cast<f64>(b.x),
+                    static_cast<f64>(b.y), static_cast<f64>(c.x), static_cast<f64>(c.y));
+}
+
+/**
+ * @brief In-circle test for four 2D points.
+ * @param ax, ay The first point of the circle.
+ * @param bx, by The second point of the circle.
+ * @param cx, cy The third point of the circle.
+ * @param dx, dy The query point.
+ * @return Positive if d lies inside the circle through a, b and c, negative if outside and zero
+ * if the four points are cocircular. a, b and c must be in counter-clockwise order, otherwise
+ * the sign is reversed. The sign is exact.
+ */
+inline f64 incircle(f64 ax, f64 ay, f64 bx, f64 by, f64 cx, f64 cy, f64 dx, f64 dy)
+{
+    const f64 adx = ax - dx;
+    const f64 ady = ay - dy;
+    const f64 bdx = bx - dx;
+    const f64 bdy = by - dy;
+    const f64 cdx = cx - dx;
+    const f64 cdy = cy - dy;
+
+    const f64 bdxcdy = bdx * cdy;
+    const f64 cdxbdy = cdx * bdy;
+    const f64 aLift = adx * adx + ady * ady;
+
+    const f64 cdxady = cdx * ady;
+    const f64 adxcdy = adx * cdy;
+    const f64 bLift = bdx * bdx + bdy * bdy;
+
+    const f64 adxbdy = adx * bdy;
+    const f64 bdxady = bdx * ady;
+    const f64 cLift = cdx * cdx + cdy * cdy;
+
+    const f64 det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) +
+                    cLift * (adxbdy - bdxady);
+    const f64 permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift +
+                          (std::abs(cdxady) + std::abs(adxcdy)) * bLift +
+                          (std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+
+    const f64 errorBound = detail::IncircleErrorBound * permanent;
+    if (det > errorBound || -det > errorBound) {
+        return det;
+    }
+    return detail::incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+/**
+ * @brief In-circle test for four 2D points.
+ * @param a The first point of the circle.
+ * @param b The second point of the circle.
+ * @param c The third point of the circle.
+ * @param d The query point.
+ * @return Positive if d lies inside the circle through the counter-clockwise triangle a, b, c,
+ * negative if outside and zero if the points are cocircular.
+ *
+ * Example usage:
+ * @code
+ * bool flip = qm::incircle(a, b, c, opposite) > 0.0; // Edge violates the Delaunay condition
+ * @endcode
+ */
+template <IsFloatingPointT T>
+f64 incircle(const vec2<T> &a, const vec2<T> &b, const vec2<T> &c, const vec2<T> &d)
+{
+    return incircle(static_cast<f64>(a.x), static_cast<f64>(a.y), static_cast<f64>(b.x),
+                    static_cast<f64>(b.y), static_cast<f64>(c.x), static_cast<f64>(c.y),
+                    static_cast<f64>(d.x), static_cast<f64>(d.y));
+}
+
+/**
+ * @brief Orientation test for four 3D points.
+ * @param a The first point of the plane.
+ * @param b The second point of the plane.
+ * @param c The third point of the plane.
+ * @param d The query point.
+ * @return Positive if d lies below the plane through a, b and c, where above is the side from
+ * which a, b and c appear counter-clockwise; negative if above and zero if the points are
+ * coplanar. The sign is exact; the magnitude approximates six times the signed volume of the
+ * tetrahedron.
+ */
+inline f64 orient3d(const f64 *a, const f64 *b, const f64 *c, const f64 *d)
+{
+    const f64 adx = a[0] - d[0];
+    const f64 bdx = b[0] - d[0];
+    const f64 cdx = c[0] - d[0];
+    const f64 ady = a[1] - d[1];
+    const f64 bdy = b[1] - d[1];
+    const f64 cdy = c[1] - d[1];
+    const f64 adz = a[2] - d[2];
+    const f64 bdz = b[2] - d[2];
+    const f64 cdz = c[2] - d[2];
+
+    const f64 bdxcdy = bdx * cdy;
+    const f64 cdxbdy = cdx * bdy;
+    const f64 cdxady = cdx * ady;
+    const f64 adxcdy = adx * cdy;
+    const f64 adxbdy = adx * bdy;
+    const f64 bdxady = bdx * ady;
+
+    const f64 det =
+        adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    const f64 permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                          (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                          (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+
+    const f64 errorBound = detail::Orient3dErrorBound * permanent;
+    if (det > errorBound || -det > errorBound) {
+        return det;
+    }
+    return detail::orient3dExact(a, b, c, d);
+}
+
+/**
+ * @brief Orientation test for four 3D points.
+ * @param a The first point of the plane.
+ * @param b The second point of the plane.
+ * @param c The third point of the plane.
+ * @param d The query point.
+ * @return Positive if d lies below the plane of the counter-clockwise triangle a, b, c,
+ * negative if above and zero if coplanar.
+ *
+ * Example usage:
+ * @code
+ * // Faces are counter-clockwise seen from outside, so outside points are negative
+ * bool visible = qm::orient3d(v0, v1, v2, eye) < 0.0;
+ * @endcode
+ */
+template <IsFloatingPointT T>
+f64 orient3d(const vec3<T> &a, const vec3<T> &b, const vec3<T> &c, const vec3<T> &d)
+{
+    const f64 pa[3] = {static_cast<f64>(a.x), static_cast<f64>(a.y), static_cast<f64>(a.z)};
+    const f64 pb[3] = {static_cast<f64>(b.x), static_cast<f64>(b.y), static_cast<f64>(b.z)};
+    const f64 pc[3] = {static_cast<f64>(c.x), static_cast<f64>(c.y), static_cast<f64>(c.z)};
+    const f64 pd[3] = {static_cast<f64>(d.x), static_cast<f64>(d.y), static_cast<f64>(d.z)};
+    return orient3d(pa, pb, pc, pd);
+}
+
+/**
+ * @brief In-sphere test for five 3D points.
+ * @param a The first point of the sphere.
+ * @param b The second point of the sphere.
+ * @param c The third point of the sphere.
+ * @param d The fourth point of the sphere.
+ * @param e The query point.
+ * @return Positive if e lies inside the sphere through a, b, c and d, negative if outside and
+ * zero if the five points are cospherical. a, b, c and d must have a positive orientation as
+ * defined by orient3d, otherwise the sign is reversed. The sign is exact.
+ */
+inline f64 insphere(const f64 *a, const f64 *b, const f64 *c, const f64 *d, const f64 *e)
+{
+    const f64 aex = a[0] - e[0];
+    const f64 bex = b[0] - e[0];
+    const f64 cex = c[0] - e[0];
+    const f64 dex = d[0] - e[0];
+    const f64 aey = a[1] - e[1];
+    const f64 bey = b[1] - e[1];
+    const f64 cey = c[1] - e[1];
+    const f64 dey = d[1] - e[1];
+    const f64 aez = a[2] - e[2];
+    const f64 bez = b[2] - e[2];
+    const f64 cez = c[2] - e[2];
+    const f64 dez = d[2] - e[2];
+
+    const f64 aexbey = aex * bey;
+    const f64 bexaey = bex * aey;
+    const f64 bexcey = bex * cey;
+    const f64 cexbey = cex * bey;
+    const f64 cexdey = cex * dey;
+    const f64 dexcey = dex * cey;
+    const f64 dexaey = dex * aey;
+    const f64 aexdey = aex * dey;
+    const f64 aexcey = aex * cey;
+    const f64 cexaey = cex * aey;
+    const f64 bexdey = bex * dey;
+    const f64 dexbey = dex * bey;
+
+    const f64 ab = aexbey - bexaey;
+    const f64 bc = bexcey - cexbey;
+    const f64 cd = cexdey - dexcey;
+    const f64 da = dexaey - aexdey;
+    const f64 ac = aexcey - cexaey;
+    const f64 bd = bexdey - dexbey;
+
+    const f64 abc = aez * bc - bez * ac + cez * ab;
+    const f64 bcd = bez * cd - cez * bd + dez * bc;
+    const f64 cda = cez * da + dez * ac + aez * cd;
+    const f64 dab = dez * ab + aez * bd + bez * da;
+
+    const f64 aLift = aex * aex + aey * aey + aez * aez;
+    const f64 bLift = bex * bex + bey * bey + bez * bez;
+    const f64 cLift = cex * cex + cey * cey + cez * cez;
+    const f64 dLift = dex * dex + dey * dey + dez * dez;
+
+    const f64 det = (dLift * abc - cLift * dab) + (bLift * cda - aLift * bcd);
+
+    const f64 aezPlus = std::abs(aez);
+    const f64 bezPlus = std::abs(bez);
+    const f64 cezPlus = std::abs(cez);
+    const f64 dezPlus = std::abs(dez);
+    const f64 aexbeyPlus = std::abs(aexbey) + std::abs(bexaey);
+    const f64 bexceyPlus = std::abs(bexcey) + std::abs(cexbey);
+    const f64 cexdeyPlus = std::abs(cexdey) + std::abs(dexcey);
+    const f64 dexaeyPlus = std::abs(dexaey) + std::abs(aexdey);
+    const f64 aexceyPlus = std::abs(aexcey) + std::abs(cexaey);
+    const f64 bexdeyPlus = std::abs(bexdey) + std::abs(dexbey);
+    const f64 permanent =
+        (cexdeyPlus * bezPlus + bexdeyPlus * cezPlus + bexceyPlus * dezPlus) * aLift +
+        (dexaeyPlus * cezPlus + aexceyPlus * dezPlus + cexdeyPlus * aezPlus) * bLift +
+        (aexbeyPlus * dezPlus + bexdeyPlus * aezPlus + dexaeyPlus * bezPlus) * cLift +
+        (bexceyPlus * aezPlus + aexceyPlus * bezPlus + aexbeyPlus * cezPlus) * dLift;
+
+    const f64 errorBound = detail::InsphereErrorBound * permanent;
+    if (det > errorBound || -det > errorBound) {
+        return det;
+    }
+    return detail::insphereExact(a, b, c, d, e);
+}
+
+/**
+ * @brief In-sphere test for five 3D points.
+ * @param a The first point of the sphere.
+ * @param b The second point of the sphere.
+ * @param c The third point of the sphere.
+ * @param d The fourth point of the sphere.
+ * @param e The query point.
+ * @return Positive if e lies inside the sphere through the positively oriented tetrahedron
+ * a, b, c, d, negative if outside and zero if the points are cospherical.
+ *
+ * Example usage:
+ * @code
+ * if (qm::orient3d(a, b, c, d) < 0.0) {
+ *     std::swap(a, b);
+ * }
+ * bool inside = qm::insphere(a, b, c, d, query) > 0.0;
+ * @endcode
+ */
+template <IsFloatingPointT T>
+f64 insphere(const vec3<T> &a, const vec3<T> &b, const vec3<T> &c, const vec3<T> &d,
+             const vec3<T> &e)
+{
+    const f64 pa[3] = {static_cast<f64>(a.x), static_cast<f64>(a.y), static_cast<f64>(a.z)};
+    const f64 pb[3] = {static_cast<f64>(b.x), static_cast<f64>(b.y), static_cast<f64>(b.z)};
+    const f64 pc[3] = {static_cast<f64>(c.x), static_cast<f64>(c.y), static_cast<f64>(c.z)};
+    const f64 pd[3] = {static_cast<f64>(d.x), static_cast<f64>(d.y), static_cast<f64>(d.z)};
+    const f64 pe[3] = {static_cast<f64>(e.x), static_cast<f64>(e.y), static_cast<f64>(e.z)};
+    return insphere(pa, pb, pc, pd, pe);
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_PREDICATES_HPP
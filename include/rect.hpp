@@ -30,7 +30,7 @@ struct Rect {
     }
 
     /**
-     * @brief Constructs a rectangle from two Vec2 points representing the top-left and bottom-right
+     * @brief Constructs a rectangle from two points representing the top-left and bottom-right
      * corners.
      *
      * This constructor calculates the rectangle's top, bottom, left, and right sides based on the
@@ -39,7 +39,7 @@ struct Rect {
      * @param topLeft The top-left corner of the rectangle.
      * @param bottomRight The bottom-right corner of the rectangle.
      */
-    constexpr Rect(const Vec2 &topLeft, const Vec2 &bottomRight)
+    constexpr Rect(const vec2<f32> &topLeft, const vec2<f32> &bottomRight)
         : Top{qm::max(topLeft.y, bottomRight.y)},
           Bottom{qm::min(topLeft.y, bottomRight.y)},
           Left{qm::min(topLeft.x, bottomRight.x)},
@@ -48,10 +48,10 @@ struct Rect {
     }
 
     /**
-     * @brief Constructs a rectangle from a Vec4 representing top, bottom, left, and right values.
-     * @param vector The Vec4 containing top, bottom, left, and right values.
+     * @brief Constructs a rectangle from a vec4 representing top, bottom, left, and right values.
+     * @param vector The vec4 containing top, bottom, left, and right values.
      */
-    constexpr Rect(const Vec4 &vector)
+    constexpr Rect(const vec4<f32> &vector)
         : Top{qm::max(vector.y, vector.w)},
           Bottom{qm::min(vector.y, vector.w)},
           Left{qm::min(vector.x, vector.z)},
@@ -85,27 +85,27 @@ struct Rect {
 
     /**
      * @brief Calculates and returns the top-left corner of the rectangle.
-     * @return The top-left corner as a Vec2.
+     * @return The top-left corner as a vec2.
      */
-    constexpr Vec2 topLeft() const { return Vec2(Left, Top); }
+    constexpr vec2<f32> topLeft() const { return vec2<f32>(Left, Top); }
 
     /**
      * @brief Calculates and returns the top-right corner of the rectangle.
-     * @return The top-right corner as a Vec2.
+     * @return The top-right corner as a vec2.
      */
-    constexpr Vec2 topRight() const { return Vec2(Right, Top); }
+    constexpr vec2<f32> topRight() const { return vec2<f32>(Right, Top); }
 
     /**
      * @brief Calculates and returns the bottom-left corner of the rectangle.
-     * @return The bottom-left corner as a Vec2.
+     * @return The bottom-left corner as a vec2.
      */
-    constexpr Vec2 bottomLeft() const { return Vec2(Left, Bottom); }
+    constexpr vec2<f32> bottomLeft() const { return vec2<f32>(Left, Bottom); }
 
     /**
      * @brief Calculates and returns the bottom-right corner of the rectangle.
-     * @return The bottom-right corner as a Vec2.
+     * @return The bottom-right corner as a vec2.
      */
-    constexpr Vec2 bottomRight() const { return Vec2(Right, Bottom); }
+    constexpr vec2<f32> bottomRight() const { return vec2<f32>(Right, Bottom); }
 
     /**
      * @brief Calculates and returns the area of the rectangle.
@@ -132,8 +132,8 @@ struct Rect {
      */
     constexpr Rect unionWith(const Rect &other) const
     {
-        return Rect(qm::min(Left, other.Left), qm::max(Right, other.Right), qm::max(Top, other.Top),
-                    qm::min(Bottom, other.Bottom));
+        return Rect(qm::max(Top, other.Top), qm::min(Bottom, other.Bottom),
+                    qm::min(Left, other.Left), qm::max(Right, other.Right));
     }
 
     /**
@@ -141,7 +141,7 @@ struct Rect {
      * @param point The point to check.
      * @return True if the point is inside the rectangle; otherwise, false.
      */
-    constexpr bool contains(const Vec2 &point) const
+    constexpr bool contains(const vec2<f32> &point) const
     {
         return (point.x >= Left && point.x <= Right && point.y >= Bottom && point.y <= Top);
     }
@@ -164,11 +164,11 @@ struct Rect {
     /**
      * @brief Clamps a specified point to be inside the rectangle.
      * @param point The point to clamp.
-     * @return The clamped point as a Vec2.
+     * @return The clamped point as a vec2.
      */
-    constexpr Vec2 clampPoint(const Vec2 &point) const
+    constexpr vec2<f32> clampPoint(const vec2<f32> &point) const
     {
-        return Vec2(qm::clamp(point.x, Left, Right), qm::clamp(point.y, Bottom, Top));
+        return vec2<f32>(qm::clamp(point.x, Left, Right), qm::clamp(point.y, Bottom, Top));
     }
 
     /**
@@ -188,7 +188,8 @@ struct Rect {
     constexpr std::string cornersToString() const
     {
         return std::format("Rect(TopLeft: {0}, TopRight: {1}, BottomLeft: {2}, BottomRight: {3})",
-                           topLeft(), topRight(), bottomLeft(), bottomRight());
+                           topLeft().toString(), topRight().toString(), bottomLeft().toString(),
+                           bottomRight().toString());
     }
 
 private:
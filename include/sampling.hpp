@@ -0,0 +1,832 @@
+#ifndef QUIKMAFF_SAMPLING_HPP
+#define QUIKMAFF_SAMPLING_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "random.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+#ifdef QM_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * Sampling from discrete distributions and streams.
+ */
+
+namespace qm {
+
+/**
+ * @brief Samples indices in proportion to their weights in constant time (Vose's alias method).
+ *
+ * Building splits the weights into n buckets of equal total probability, each holding at most
+ * two outcomes: its own index, kept with some probability, and an alias. Sampling picks a
+ * bucket uniformly and flips one biased coin, so a draw costs two random numbers and one
+ * memory access however many weights there are. Construction is O(n) using Vose's stable
+ * pairing of under- and over-full buckets.
+ *
+ * Example usage:
+ * @code
+ * qm::AliasTable loot;
+ * loot.build(dropWeights);
+ * u32 item = loot.sample(randGen);
+ * @endcode
+ */
+class AliasTable {
+public:
+    /**
+     * @brief Builds the table.
+     * @param weights Non-negative weights, not all zero.
+     */
+    void build(std::span<const f32> weights)
+    {
+        m_worklist.resize(weights.size());
+        build(weights, m_worklist);
+    }
+
+    /**
+     * @brief Builds the table using caller-provided scratch memory. Once the table has held this
+     * many weights before, nothing is allocated.
+     * @param weights Non-negative weights, not all zero.
+     * @param scratch At least weights.size() elements.
+     */
+    void build(std::span<const f32> weights, std::span<u32> scratch)
+    {
+        const u32 count = static_cast<u32>(weights.size());
+        QM_ASSERT(count > 0 && scratch.size() >= count);
+        m_buckets.resize(count);
+
+        f64 total = 0.0;
+        for (const f32 weight : weights) {
+            QM_ASSERT(weight >= 0.0f);
+            total += weight;
+        }
+        QM_ASSERT(total > 0.0);
+
+        // Scale so the average bucket holds 1, then sort buckets into under-full ones growing
+        // from the front of the scratch and over-full ones growing from the back
+        const f64 scale = static_cast<f64>(count) / total;
+        u32 smallCount = 0;
+        u32 largeBegin = count;
+        for (u32 i = 0; i < count; ++i) {
+            m_buckets[i].Probability = static_cast<f32>(weights[i] * scale);
+            if (m_buckets[i].Probability < 1.0f) {
+                scratch[smallCount++] = i;
+            }
+            else {
+                scratch[--largeBegin] = i;
+            }
+        }
+
+        // Top up each under-full bucket from an over-full one, which may become under-full
+        while (smallCount > 0 && largeBegin < count) {
+            const u32 small = scratch[--smallCount];
+            const u32 large = scratch[largeBegin];
+            m_buckets[small].Alias = large;
+
+            Bucket &donor = m_buckets[large];
+            donor.Probability = (donor.Probability + m_buckets[small].Probability) - 1.0f;
+            if (donor.Probability < 1.0f) {
+                ++largeBegin;
+                scratch[smallCount++] = large;
+            }
+        }
+
+        // Whatever remains is full up to rounding
+        for (u32 i = 0; i < smallCount; ++i) {
+            makeFull(scratch[i]);
+        }
+        for (u32 i = largeBegin; i < count; ++i) {
+            makeFull(scratch[i]);
+        }
+    }
+
+    /**
+     * @brief Returns the number of weights in the table.
+     */
+    std::size_t size() const { return m_buckets.size(); }
+
+    /**
+     * @brief Draws an index.
+     * @param random The generator to draw from.
+     * @return An index, with probability proportional to its weight.
+     */
+    u32 sample(Random &random) const
+    {
+        const u32 bucket = static_cast<u32>(random.rand(0, static_cast<int>(m_buckets.size()) - 1));
+        return resolve(bucket, random.rand());
+    }
+
+    /**
+     * @brief Draws many indices.
+     * @param random The generator to draw from. Its mutex is taken twice per 256 draws rather
+     * than twice per draw.
+     * @param out Receives the indices.
+     */
+    void sample(Random &random, std::span<u32> out) const
+    {
+        const int lastBucket = static_cast<int>(m_buckets.size()) - 1;
+        int buckets[256];
+        u32 coins[256];
+        for (std::size_t begin = 0; begin < out.size(); begin += 256) {
+            const std::size_t count = qm::min<std::size_t>(256, out.size() - begin);
+            random.randFill(std::span<int>(buckets, count), 0, lastBucket);
+            random.randFill(std::span<u32>(coins, count));
+            for (std::size_t i = 0; i < count; ++i) {
+                out[begin + i] = resolve(static_cast<u32>(buckets[i]), coins[i]);
+            }
+        }
+    }
+
+private:
+    struct Bucket {
+        f32 Probability; // Chance of keeping the bucket's own index
+        u32 Alias;
+    };
+
+    void makeFull(u32 index)
+    {
+        m_buckets[index].Probability = 1.0f;
+        m_buckets[index].Alias = index;
+    }
+
+    u32 resolve(u32 bucket, u32 coin) const
+    {
+        const Bucket &b = m_buckets[bucket];
+        return detail::unitFloat(coin) < b.Probability ? bucket : b.Alias;
+    }
+
+    std::vector<Bucket> m_buckets;
+    std::vector<u32> m_worklist;
+};
+
+namespace detail {
+
+// A uniform double in (0, 1) from two draws, never exactly 0 so its logarithm is finite.
+inline f64 openUnitDouble(Random &random)
+{
+    const u64 bits = (static_cast<u64>(random.rand()) << 21) ^ (random.rand() >> 11);
+    return (static_cast<f64>(bits & ((1ULL << 53) - 1)) + 0.5) * 0x1p-53;
+}
+
+} // namespace detail
+
+/**
+ * @brief Selects k items uniformly from a stream of unknown length in one pass (Algorithm L).
+ *
+ * Every item seen so far is equally likely to be in the reservoir. Once the reservoir is full,
+ * the number of items to skip before the next replacement is drawn directly from a geometric
+ * distribution, so random numbers are only spent on the O(k log(n / k)) items that are
+ * actually taken and add() is a counter decrement for the rest.
+ *
+ * Each entry keeps the uniform key it would have in a keyed reservoir (the k smallest of n
+ * independent uniforms), which makes merging exact: the merged reservoir is the k smallest
+ * keys of both. Threads can therefore sample parts of a stream independently and merge.
+ *
+ * @tparam T The item type.
+ *
+ * Example usage:
+ * @code
+ * qm::ReservoirSampler<Event> sampler(1000);
+ * for (const Event &event : stream) {
+ *     sampler.add(event, randGen);
+ * }
+ * @endcode
+ */
+template <typename T>
+class ReservoirSampler {
+public:
+    /**
+     * @brief Constructs an empty reservoir.
+     * @param capacity Number of items to select.
+     */
+    explicit ReservoirSampler(std::size_t capacity) : m_capacity{capacity}
+    {
+        QM_ASSERT(capacity > 0);
+        m_entries.reserve(capacity);
+    }
+
+    /**
+     * @brief Offers the next item of the stream.
+     * @param item The item.
+     * @param random The generator to draw from.
+     */
+    void add(const T &item, Random &random)
+    {
+        ++m_count;
+        if (m_entries.size() < m_capacity) {
+            push({item, detail::openUnitDouble(random)});
+            if (m_entries.size() == m_capacity) {
+                drawSkip(random);
+            }
+            return;
+        }
+        if (m_skip > 0) {
+            --m_skip;
+            return;
+        }
+
+        // The taken item's key is uniform below the largest key, which it evicts
+        const f64 key = m_entries.front().Key * detail::openUnitDouble(random);
+        std::pop_heap(m_entries.begin(), m_entries.end(), LargerKeyFirst{});
+        m_entries.back() = {item, key};
+        std::push_heap(m_entries.begin(), m_entries.end(), LargerKeyFirst{});
+        drawSkip(random);
+    }
+
+    /**
+     * @brief Merges in a reservoir filled from a disjoint part of the stream.
+     * @param other A reservoir of the same capacity.
+     * @param random The generator to draw from.
+     */
+    void merge(const ReservoirSampler &other, Random &random)
+    {
+        QM_ASSERT(other.m_capacity == m_capacity);
+        for (const Entry &entry : other.m_entries) {
+            if (m_entries.size() < m_capacity) {
+                push(entry);
+            }
+            else if (entry.Key < m_entries.front().Key) {
+                std::pop_heap(m_entries.begin(), m_entries.end(), LargerKeyFirst{});
+                m_entries.back() = entry;
+                std::push_heap(m_entries.begin(), m_entries.end(), LargerKeyFirst{});
+            }
+        }
+        m_count += other.m_count;
+        if (m_entries.size() == m_capacity) {
+            drawSkip(random);
+        }
+    }
+
+    /**
+     * @brief Returns the number of selected items, min(capacity, count()).
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @brief Returns a selected item, in no particular order.
+     */
+    const T &operator[](std::size_t i) const { return m_entries[i].Item; }
+
+    /**
+     * @brief Returns the number of items offered so far.
+     */
+    u64 count() const { return m_count; }
+
+    /**
+     * @brief Empties the reservoir, keeping its capacity.
+     */
+    void clear()
+    {
+        m_entries.clear();
+        m_count = 0;
+        m_skip = 0;
+    }
+
+private:
+    struct Entry {
+        T Item;
+        f64 Key;
+    };
+
+    struct LargerKeyFirst {
+        bool operator()(const Entry &a, const Entry &b) const { return a.Key < b.Key; }
+    };
+
+    void push(const Entry &entry)
+    {
+        m_entries.push_back(entry);
+        std::push_heap(m_entries.begin(), m_entries.end(), LargerKeyFirst{});
+    }
+
+    // Each later item is taken with probability equal to the largest key, so the gap to the
+    // next one taken is geometric.
+    void drawSkip(Random &random)
+    {
+        const f64 u = detail::openUnitDouble(random);
+        const f64 skip = std::floor(std::log(u) / std::log1p(-m_entries.front().Key));
+        m_skip = skip < 0x1p63 ? static_cast<u64>(skip) : std::numeric_limits<u64>::max();
+    }
+
+    std::vector<Entry> m_entries; // Max-heap on key
+    std::size_t m_capacity;
+    u64 m_count = 0;
+    u64 m_skip = 0;
+};
+
+/**
+ * @brief Selects k items from a weighted stream of unknown length in one pass (A-ExpJ).
+ *
+ * Implements Efraimidis and Spirakis' weighted sampling without replacement: each item gets the
+ * key u^(1/w) and the reservoir keeps the k largest. With exponential jumps, the total weight
+ * to skip before the next replacement is drawn directly, so random numbers are only spent on
+ * items that are taken. Keys are kept as logarithms so tiny weights do not underflow.
+ *
+ * Merging keeps the k largest keys of both reservoirs, which is exact, so per-thread reservoirs
+ * over disjoint parts of a stream combine into a sample of the whole stream, as in ReSTIR-style
+ * light selection.
+ *
+ * @tparam T The item type.
+ *
+ * Example usage:
+ * @code
+ * qm::WeightedReservoirSampler<u32> lights(4);
+ * for (u32 i = 0; i < lightCount; ++i) {
+ *     lights.add(i, contribution(i), randGen);
+ * }
+ * @endcode
+ */
+template <typename T>
+class WeightedReservoirSampler {
+public:
+    /**
+     * @brief Constructs an empty reservoir.
+     * @param capacity Number of items to select.
+     */
+    explicit WeightedReservoirSampler(std::size_t capacity) : m_capacity{capacity}
+    {
+        QM_ASSERT(capacity > 0);
+        m_entries.reserve(capacity);
+    }
+
+    /**
+     * @brief Offers the next item of the stream.
+     * @param item The item.
+     * @param weight The item's weight; items with weight 0 or less are never selected.
+     * @param random The generator to draw from.
+     */
+    void add(const T &item, f64 weight, Random &random)
+    {
+        if (!(weight > 0.0)) {
+            return;
+        }
+        m_totalWeight += weight;
+
+        if (m_entries.size() < m_capacity) {
+            push({item, std::log(detail::openUnitDouble(random)) / weight});
+            if (m_entries.size() == m_capacity) {
+                drawJump(random);
+            }
+            return;
+        }
+        m_jump -= weight;
+        if (m_jump > 0.0) {
+            return;
+        }
+
+        // The taken item's key is uniform between the threshold key and 1
+        const f64 threshold = std::exp(m_entries.front().LogKey * weight);
+        const f64 key = threshold + (1.0 - threshold) * detail::openUnitDouble(random);
+        std::pop_heap(m_entries.begin(), m_entries.end(), SmallerKeyFirst{});
+        m_entries.back() = {item, std::log(key) / weight};
+        std::push_heap(m_entries.begin(), m_entries.end(), SmallerKeyFirst{});
+        drawJump(random);
+    }
+
+    /**
+     * @brief Merges in a reservoir filled from a disjoint part of the stream.
+     * @param other A reservoir of the same capacity.
+     * @param random The generator to draw from.
+     */
+    void merge(const WeightedReservoirSampler &other, Random &random)
+    {
+        QM_ASSERT(other.m_capacity == m_capacity);
+        for (const Entry &entry : other.m_entries) {
+            if (m_entries.size() < m_capacity) {
+                push(entry);
+            }
+            else if (entry.LogKey > m_entries.front().LogKey) {
+                std::pop_heap(m_entries.begin(), m_entries.end(), SmallerKeyFirst{});
+                m_entries.back() = entry;
+                std::push_heap(m_entries.begin(), m_entries.end(), SmallerKeyFirst{});
+            }
+        }
+        m_totalWeight += other.m_totalWeight;
+        if (m_entries.size() == m_capacity) {
+            drawJump(random);
+        }
+    }
+
+    /**
+     * @brief Returns the number of selected items.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+    /**
+     * @brief Returns a selected item, in no particular order.
+     */
+    const T &operator[](std::size_t i) const { return m_entries[i].Item; }
+
+    /**
+     * @brief Returns the total weight offered so far.
+     */
+    f64 totalWeight() const { return m_totalWeight; }
+
+    /**
+     * @brief Empties the reservoir, keeping its capacity.
+     */
+    void clear()
+    {
+        m_entries.clear();
+        m_totalWeight = 0.0;
+        m_jump = 0.0;
+    }
+
+private:
+    struct Entry {
+        T Item;
+        f64 LogKey;
+    };
+
+    struct SmallerKeyFirst {
+        bool operator()(const Entry &a, const Entry &b) const { return a.LogKey > b.LogKey; }
+    };
+
+    void push(const Entry &entry)
+    {
+        m_entries.push_back(entry);
+        std::push_heap(m_entries.begin(), m_entries.end(), SmallerKeyFirst{});
+    }
+
+    // An item of weight w beats the smallest key T with probability 1 - T^w, so the weight
+    // passed before the next one that does is log(u) / log(T).
+    void drawJump(Random &random)
+    {
+        m_jump = std::log(detail::openUnitDouble(random)) / m_entries.front().LogKey;
+    }
+
+    std::vector<Entry> m_entries; // Min-heap on key
+    std::size_t m_capacity;
+    f64 m_totalWeight = 0.0;
+    f64 m_jump = 0.0;
+};
+
+namespace detail {
+
+/*
+ * Sine and cosine of the angle word * 2pi / 2^32 without a branch or a range reduction in
+ * floating point: the word is split exactly into the nearest quarter turn and a signed remainder
+ * of at most an eighth of a turn, whose sine and cosine are short polynomials. Lanes of the AVX2
+ * version produce the same bits as the scalar one.
+ */
+constexpr f32 TurnToRadians = 2.0f * 3.14159265358979f * 0x1p-32f;
+
+// a * b + c. Fused explicitly when FMA is available, as leaving it to the compiler's contraction
+// rules can round the scalar and AVX2 polynomials differently.
+inline f32 multiplyAdd(f32 a, f32 b, f32 c)
+{
+#ifdef QM_FMA
+    return std::fma(a, b, c);
+#else
+    return a * b + c;
+#endif
+}
+
+#ifdef QM_AVX2
+inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+#ifdef QM_FMA
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+// Horner's rule, highest-order coefficient first.
+inline f32 polynomial(f32 x, std::initializer_list<f32> coefficients)
+{
+    f32 result = 0.0f;
+    for (const f32 coefficient : coefficients) {
+        result = multiplyAdd(result, x, coefficient);
+    }
+    return result;
+}
+
+inline void sinCosTurn(u32 word, f32 &sine, f32 &cosine)
+{
+    const u32 quadrant = (word + (1u << 29)) >> 30;
+    const f32 a = static_cast<f32>(static_cast<i32>(word - (quadrant << 30))) * TurnToRadians;
+    const f32 a2 = a * a;
+    const f32 s = a * polynomial(a2, {1.0f / 362880, -1.0f / 5040, 1.0f / 120, -1.0f / 6, 1.0f});
+    const f32 c =
+        polynomial(a2, {-1.0f / 3628800, 1.0f / 40320, -1.0f / 720, 1.0f / 24, -0.5f, 1.0f});
+
+    const bool swap = (quadrant & 1u) != 0;
+    sine = std::bit_cast<f32>(std::bit_cast<u32>(swap ? c : s) ^ ((quadrant & 2u) << 30));
+    cosine = std::bit_cast<f32>(std::bit_cast<u32>(swap ? s : c) ^ (((quadrant + 1u) & 2u) << 30));
+}
+
+inline void sinCosTurns(const u32 *words, std::size_t count, f32 *sines, f32 *cosines)
+{
+    std::size_t i = 0;
+
+#ifdef QM_AVX2
+    auto polynomial = [](__m256 a2, std::initializer_list<f32> coefficients) {
+        __m256 result = _mm256_setzero_ps();
+        for (const f32 coefficient : coefficients) {
+            result = multiplyAdd(result, a2, _mm256_set1_ps(coefficient));
+        }
+        return result;
+    };
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+        const __m256i quadrant =
+            _mm256_srli_epi32(_mm256_add_epi32(word, _mm256_set1_epi32(1 << 29)), 30);
+        const __m256i remainder = _mm256_sub_epi32(word, _mm256_slli_epi32(quadrant, 30));
+        const __m256 a =
+            _mm256_mul_ps(_mm256_cvtepi32_ps(remainder), _mm256_set1_ps(TurnToRadians));
+        const __m256 a2 = _mm256_mul_ps(a, a);
+        const __m256 s = _mm256_mul_ps(
+            a, polynomial(a2, {1.0f / 362880, -1.0f / 5040, 1.0f / 120, -1.0f / 6, 1.0f}));
+        const __m256 c =
+            polynomial(a2, {-1.0f / 3628800, 1.0f / 40320, -1.0f / 720, 1.0f / 24, -0.5f, 1.0f});
+
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i two = _mm256_set1_epi32(2);
+        const __m256 swap =
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+        const __m256 sineSign =
+            _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30));
+        const __m256 cosineSign = _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30));
+        _mm256_storeu_ps(sines + i, _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sineSign));
+        _mm256_storeu_ps(cosines + i, _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosineSign));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        sinCosTurn(words[i], sines[i], cosines[i]);
+    }
+}
+
+// Batch shape samplers draw this many samples' words per lock of the generator.
+constexpr std::size_t ShapeBlock = 256;
+
+// Calls emit(out[i], sine, cosine, extraWords) for every output position, drawing one angle
+// word plus ExtraWords further words per sample.
+template <u32 ExtraWords, typename T, typename Emit>
+void fillShape(Random &random, std::span<T> out, Emit emit)
+{
+    u32 words[ShapeBlock * (1 + ExtraWords)];
+    f32 sines[ShapeBlock];
+    f32 cosines[ShapeBlock];
+
+    for (std::size_t begin = 0; begin < out.size(); begin += ShapeBlock) {
+        const std::size_t count = qm::min(ShapeBlock, out.size() - begin);
+        random.randFill(std::span<u32>(words, count * (1 + ExtraWords)));
+        sinCosTurns(words, count, sines, cosines);
+        for (std::size_t i = 0; i < count; ++i) {
+            emit(out[begin + i], sines[i], cosines[i], words + count + i * ExtraWords);
+        }
+    }
+}
+
+} // namespace detail
+
+/*
+ * Uniform samples on and in simple shapes, for particle emitters and ray tracers. Every sampler
+ * maps a fixed number of random words to a sample without rejection, so costs are predictable
+ * and batches vectorize. The span overloads draw words 256 samples at a time under one lock and
+ * evaluate the angles with AVX2 when QM_AVX2 is defined.
+ */
+
+/**
+ * @brief Returns a uniformly distributed point on the unit circle.
+ * @param random The generator to draw from.
+ *
+ * Example usage:
+ * @code
+ * vec2<f32> direction = qm::sampleUnitCircle(randGen);
+ * @endcode
+ */
+inline vec2<f32> sampleUnitCircle(Random &random)
+{
+    f32 s, c;
+    detail::sinCosTurn(random.rand(), s, c);
+    return {c, s};
+}
+
+/**
+ * @brief Fills a span with uniformly distributed points on the unit circle.
+ * @param random The generator to draw from.
+ * @param out Receives the points.
+ */
+inline void sampleUnitCircle(Random &random, std::span<vec2<f32>> out)
+{
+    detail::fillShape<0>(random, out, [](vec2<f32> &p, f32 s, f32 c, const u32 *) { p = {c, s}; });
+}
+
+/**
+ * @brief Returns a uniformly distributed point in the unit disk.
+ * @param random The generator to draw from.
+ */
+inline vec2<f32> sampleDisk(Random &random)
+{
+    f32 s, c;
+    detail::sinCosTurn(random.rand(), s, c);
+    const f32 r = qm::sqrt(detail::unitFloat(random.rand()));
+    return {r * c, r * s};
+}
+
+/**
+ * @brief Fills a span with uniformly distributed points in the unit disk.
+ * @param random The generator to draw from.
+ * @param out Receives the points.
+ */
+inline void sampleDisk(Random &random, std::span<vec2<f32>> out)
+{
+    detail::fillShape<1>(random, out, [](vec2<f32> &p, f32 s, f32 c, const u32 *extra) {
+        const f32 r = qm::sqrt(detail::unitFloat(extra[0]));
+        p = {r * c, r * s};
+    });
+}
+
+namespace detail {
+
+// Archimedes: z is uniform on the sphere, and the ring at height z has radius sqrt(1 - z^2),
+// written as 2 sqrt(u (1 - u)) to keep precision near the poles.
+inline vec3<f32> spherePoint(f32 s, f32 c, u32 heightWord)
+{
+    const f32 u = unitFloat(heightWord);
+    const f32 r = 2.0f * qm::sqrt(u * (1.0f - u));
+    return {r * c, r * s, 1.0f - 2.0f * u};
+}
+
+// Malley's method: a uniform disk point lifted to the hemisphere is cosine distributed.
+inline vec3<f32> cosineHemispherePoint(f32 s, f32 c, u32 radiusWord)
+{
+    const f32 r2 = unitFloat(radiusWord);
+    const f32 r = qm::sqrt(r2);
+    return {r * c, r * s, qm::sqrt(1.0f - r2)};
+}
+
+// Folds the unit square onto the triangle below its diagonal.
+inline vec3<f32> barycentricPoint(u32 word0, u32 word1)
+{
+    f32 u = unitFloat(word0);
+    f32 v = unitFloat(word1);
+    const bool fold = u + v > 1.0f;
+    u = fold ? 1.0f - u : u;
+    v = fold ? 1.0f - v : v;
+    return {1.0f - u - v, u, v};
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns a uniformly distributed point on the unit sphere.
+ * @param random The generator to draw from.
+ *
+ * Example usage:
+ * @code
+ * vec3<f32> velocity = qm::sampleUnitSphere(randGen) * speed;
+ * @endcode
+ */
+inline vec3<f32> sampleUnitSphere(Random &random)
+{
+    f32 s, c;
+    detail::sinCosTurn(random.rand(), s, c);
+    return detail::spherePoint(s, c, random.rand());
+}
+
+/**
+ * @brief Fills a span with uniformly distributed points on the unit sphere.
+ * @param random The generator to draw from.
+ * @param out Receives the points.
+ */
+inline void sampleUnitSphere(Random &random, std::span<vec3<f32>> out)
+{
+    detail::fillShape<1>(random, out, [](vec3<f32> &p, f32 s, f32 c, const u32 *extra) {
+        p = detail::spherePoint(s, c, extra[0]);
+    });
+}
+
+/**
+ * @brief Returns a uniformly distributed point in the unit ball.
+ * @param random The generator to draw from.
+ */
+inline vec3<f32> sampleBall(Random &random)
+{
+    f32 s, c;
+    detail::sinCosTurn(random.rand(), s, c);
+    const vec3<f32> direction = detail::spherePoint(s, c, random.rand());
+    return direction * std::cbrt(detail::unitFloat(random.rand()));
+}
+
+/**
+ * @brief Fills a span with uniformly distributed points in the unit ball.
+ * @param random The generator to draw from.
+ * @param out Receives the points.
+ */
+inline void sampleBall(Random &random, std::span<vec3<f32>> out)
+{
+    detail::fillShape<2>(random, out, [](vec3<f32> &p, f32 s, f32 c, const u32 *extra) {
+        p = detail::spherePoint(s, c, extra[0]) * std::cbrt(detail::unitFloat(extra[1]));
+    });
+}
+
+/**
+ * @brief Returns a cosine-weighted direction on the hemisphere around +z.
+ * @param random The generator to draw from.
+ *
+ * The density is cos(theta) / pi, which cancels the cosine term of diffuse reflection. Rotate
+ * the result into the frame of the surface normal.
+ */
+inline vec3<f32> sampleCosineHemisphere(Random &random)
+{
+    f32 s, c;
+    detail::sinCosTurn(random.rand(), s, c);
+    return detail::cosineHemispherePoint(s, c, random.rand());
+}
+
+/**
+ * @brief Fills a span with cosine-weighted directions on the hemisphere around +z.
+ * @param random The generator to draw from.
+ * @param out Receives the directions.
+ */
+inline void sampleCosineHemisphere(Random &random, std::span<vec3<f32>> out)
+{
+    detail::fillShape<1>(random, out, [](vec3<f32> &p, f32 s, f32 c, const u32 *extra) {
+        p = detail::cosineHemispherePoint(s, c, extra[0]);
+    });
+}
+
+/**
+ * @brief Returns uniformly distributed barycentric coordinates of a triangle.
+ * @param random The generator to draw from.
+ * @return Non-negative weights summing to 1.
+ */
+inline vec3<f32> sampleBarycentric(Random &random)
+{
+    const u32 word0 = random.rand();
+    return detail::barycentricPoint(word0, random.rand());
+}
+
+/**
+ * @brief Fills a span with uniformly distributed barycentric coordinates of a triangle.
+ * @param random The generator to draw from.
+ * @param out Receives the coordinates.
+ */
+inline void sampleBarycentric(Random &random, std::span<vec3<f32>> out)
+{
+    u32 words[detail::ShapeBlock * 2];
+    for (std::size_t begin = 0; begin < out.size(); begin += detail::ShapeBlock) {
+        const std::size_t count = qm::min(detail::ShapeBlock, out.size() - begin);
+        random.randFill(std::span<u32>(words, count * 2));
+        for (std::size_t i = 0; i < count; ++i) {
+            out[begin + i] = detail::barycentricPoint(words[2 * i], words[2 * i + 1]);
+        }
+    }
+}
+
+/**
+ * @brief Returns a uniformly distributed point in a triangle.
+ * @param random The generator to draw from.
+ * @param a, b, c The triangle's corners.
+ *
+ * Example usage:
+ * @code
+ * vec3<f32> spawn = qm::sampleTriangle(randGen, v0, v1, v2);
+ * @endcode
+ */
+template <typename VecT>
+inline VecT sampleTriangle(Random &random, const VecT &a, const VecT &b, const VecT &c)
+{
+    const vec3<f32> w = sampleBarycentric(random);
+    return a + (b - a) * w.y + (c - a) * w.z;
+}
+
+/**
+ * @brief Fills a span with uniformly distributed points in a triangle.
+ * @param random The generator to draw from.
+ * @param a, b, c The triangle's corners.
+ * @param out Receives the points.
+ */
+template <typename VecT>
+inline void sampleTriangle(Random &random, const VecT &a, const VecT &b, const VecT &c,
+                           std::span<VecT> out)
+{
+    u32 words[detail::ShapeBlock * 2];
+    const VecT ab = b - a;
+    const VecT ac = c - a;
+    for (std::size_t begin = 0; begin < out.size(); begin += detail::ShapeBlock) {
+        const std::size_t count = qm::min(detail::ShapeBlock, out.size() - begin);
+        random.randFill(std::span<u32>(words, count * 2));
+        for (std::size_t i = 0; i < count; ++i) {
+            const vec3<f32> w = detail::barycentricPoint(words[2 * i], words[2 * i + 1]);
+            out[begin + i] = a + ab * w.y + ac * w.z;
+        }
+    }
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_SAMPLING_HPP
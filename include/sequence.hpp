@@ -0,0 +1,385 @@
+#ifndef QUIKMAFF_SEQUENCE_HPP
+#define QUIKMAFF_SEQUENCE_HPP
+
+#include <array>
+#include <bit>
+#include <span>
+
+#include "functions.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+/**
+ * Low-discrepancy (quasi-random) sequences.
+ *
+ * Samples from these sequences cover the unit square or cube far more evenly than independent
+ * random numbers, so Monte Carlo estimates converge faster for the same sample count. Every
+ * generator evaluates any index directly, so samples can be drawn in parallel or out of order,
+ * and fill() writes a run of consecutive indices. Coordinates lie in [0, 1).
+ */
+
+namespace qm {
+
+namespace detail {
+
+// Sobol direction numbers for the first three dimensions (Joe and Kuo), expanded with the
+// recurrence of each dimension's primitive polynomial.
+constexpr std::array<std::array<u32, 32>, 3> makeSobolDirections()
+{
+    std::array<std::array<u32, 32>, 3> directions{};
+
+    // The first dimension is the van der Corput sequence in base 2
+    for (u32 k = 0; k < 32; ++k) {
+        directions[0][k] = 1u << (31 - k);
+    }
+
+    struct Polynomial {
+        u32 Degree;
+        u32 Coefficients; // Inner coefficients a_1 .. a_{s-1}, a_1 the most significant
+        u32 Initial[2];
+    };
+    constexpr Polynomial polynomials[2] = {{1, 0, {1, 0}}, {2, 1, {1, 3}}};
+
+    for (u32 d = 0; d < 2; ++d) {
+        const Polynomial &p = polynomials[d];
+        u32 m[33] = {};
+        for (u32 k = 1; k <= p.Degree; ++k) {
+            m[k] = p.Initial[k - 1];
+        }
+        for (u32 k = p.Degree + 1; k <= 32; ++k) {
+            m[k] = m[k - p.Degree] ^ (m[k - p.Degree] << p.Degree);
+            for (u32 j = 1; j < p.Degree; ++j) {
+                if ((p.Coefficients >> (p.Degree - 1 - j)) & 1u) {
+                    m[k] ^= m[k - j] << j;
+                }
+            }
+        }
+        for (u32 k = 1; k <= 32; ++k) {
+            directions[d + 1][k - 1] = m[k] << (32 - k);
+        }
+    }
+    return directions;
+}
+
+constexpr std::array<std::array<u32, 32>, 3> SobolDirections = makeSobolDirections();
+
+// Burley's hash-based nested uniform scramble: a Laine-Karras style hash applied to the
+// bit-reversed value permutes every level of the base-2 digit tree, as Owen scrambling does.
+constexpr u32 laineKarrasPermutation(u32 x, u32 seed)
+{
+    x ^= x * 0x3d20adeau;
+    x += seed;
+    x *= (seed >> 16) | 1u;
+    x ^= x * 0x05526c56u;
+    x ^= x * 0x53a22864u;
+    return x;
+}
+
+constexpr u32 reverseBits(u32 x)
+{
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+constexpr u32 nestedUniformScramble(u32 x, u32 seed)
+{
+    return reverseBits(laineKarrasPermutation(reverseBits(x), seed));
+}
+
+constexpr u32 hashCombine(u32 seed, u32 value)
+{
+    return seed ^ (value + 0x9e3779b9u + (seed << 6) + (seed >> 2));
+}
+
+} // namespace detail
+
+/**
+ * @brief The Sobol sequence in up to three dimensions, optionally Owen-scrambled.
+ *
+ * Unscrambled, the first 2^k points of any two dimensions are perfectly stratified, but the
+ * sequence is deterministic and its structure can alias with the integrand. Owen scrambling
+ * randomly permutes the digits at every level, which keeps the stratification, decorrelates
+ * the dimensions and makes the estimate unbiased; different seeds give independent
+ * realizations. The scramble is Burley's hash-based variant, so it needs no tables and any
+ * index can be evaluated directly.
+ *
+ * Example usage:
+ * @code
+ * const qm::SobolSequence sobol(pixelSeed);
+ * for (u32 i = 0; i < sampleCount; ++i) {
+ *     vec2f uv = sobol.sample2(i);
+ *     // ... trace a ray through the pixel at uv
+ * }
+ * @endcode
+ */
+class SobolSequence {
+public:
+    /**
+     * @brief Constructs the unscrambled sequence.
+     */
+    constexpr SobolSequence() = default;
+
+    /**
+     * @brief Constructs an Owen-scrambled sequence.
+     * @param seed Selects the scramble.
+     */
+    explicit constexpr SobolSequence(u32 seed) : m_seed{seed}, m_scrambled{true} {}
+
+    /**
+     * @brief Returns one coordinate of a sample.
+     * @param index The sample index.
+     * @param dimension The coordinate, 0 to 2.
+     * @return The coordinate in [0, 1).
+     */
+    constexpr f32 sample(u32 index, u32 dimension) const
+    {
+        return detail::unitFloat(sampleBits(shuffledIndex(index), dimension));
+    }
+
+    /**
+     * @brief Returns a 2D sample.
+     */
+    constexpr vec2<f32> sample2(u32 index) const
+    {
+        const u32 i = shuffledIndex(index);
+        return {detail::unitFloat(sampleBits(i, 0)),
+                detail::unitFloat(sampleBits(i, 1))};
+    }
+
+    /**
+     * @brief Returns a 3D sample.
+     */
+    constexpr vec3<f32> sample3(u32 index) const
+    {
+        const u32 i = shuffledIndex(index);
+        return {detail::unitFloat(sampleBits(i, 0)),
+                detail::unitFloat(sampleBits(i, 1)),
+                detail::unitFloat(sampleBits(i, 2))};
+    }
+
+    /**
+     * @brief Fills a span with consecutive 2D samples.
+     * @param firstIndex Index of out[0].
+     * @param out Receives sample2(firstIndex + i) at position i.
+     */
+    void fill(u32 firstIndex, std::span<vec2<f32>> out) const
+    {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = sample2(firstIndex + static_cast<u32>(i));
+        }
+    }
+
+    /**
+     * @brief Fills a span with consecutive 3D samples.
+     * @param firstIndex Index of out[0].
+     * @param out Receives sample3(firstIndex + i) at position i.
+     */
+    void fill(u32 firstIndex, std::span<vec3<f32>> out) const
+    {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = sample3(firstIndex + static_cast<u32>(i));
+        }
+    }
+
+private:
+    // Scrambling the index too gives a random-looking order within each power-of-two prefix
+    constexpr u32 shuffledIndex(u32 index) const
+    {
+        return m_scrambled ? detail::nestedUniformScramble(index, m_seed) : index;
+    }
+
+    // The sample as a 32-bit fixed-point fraction: the XOR of the direction numbers selected by
+    // the set bits of the index.
+    constexpr u32 sampleBits(u32 index, u32 dimension) const
+    {
+        QM_ASSERT(dimension < 3);
+        const std::array<u32, 32> &directions = detail::SobolDirections[dimension];
+        u32 result = 0;
+        for (u32 bit = 0; index != 0; index >>= 1, ++bit) {
+            if (index & 1u) {
+                result ^= directions[bit];
+            }
+        }
+        if (m_scrambled) {
+            result =
+                detail::nestedUniformScramble(result, detail::hashCombine(m_seed, dimension + 1));
+        }
+        return result;
+    }
+
+    u32 m_seed = 0;
+    bool m_scrambled = false;
+};
+
+/**
+ * @brief The Halton sequence in bases 2, 3 and 5.
+ *
+ * Each coordinate is the radical inverse of the index, its digits mirrored around the radix
+ * point. Halton points stratify well in low dimensions for any sample count, not only for
+ * powers of two.
+ *
+ * Example usage:
+ * @code
+ * const qm::HaltonSequence halton;
+ * vec3f u = halton.sample3(i);
+ * @endcode
+ */
+class HaltonSequence {
+public:
+    /**
+     * @brief Returns one coordinate of a sample.
+     * @param index The sample index.
+     * @param dimension The coordinate, 0 to 2, using base 2, 3 or 5.
+     * @return The coordinate in [0, 1).
+     */
+    constexpr f32 sample(u32 index, u32 dimension) const
+    {
+        QM_ASSERT(dimension < 3);
+        if (dimension == 0) {
+            return detail::unitFloat(detail::reverseBits(index));
+        }
+        return radicalInverse(index, dimension == 1 ? 3 : 5);
+    }
+
+    /**
+     * @brief Returns a 2D sample.
+     */
+    constexpr vec2<f32> sample2(u32 index) const { return {sample(index, 0), sample(index, 1)}; }
+
+    /**
+     * @brief Returns a 3D sample.
+     */
+    constexpr vec3<f32> sample3(u32 index) const
+    {
+        return {sample(index, 0), sample(index, 1), sample(index, 2)};
+    }
+
+    /**
+     * @brief Fills a span with consecutive 2D samples.
+     * @param firstIndex Index of out[0].
+     * @param out Receives sample2(firstIndex + i) at position i.
+     */
+    void fill(u32 firstIndex, std::span<vec2<f32>> out) const
+    {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = sample2(firstIndex + static_cast<u32>(i));
+        }
+    }
+
+    /**
+     * @brief Fills a span with consecutive 3D samples.
+     * @param firstIndex Index of out[0].
+     * @param out Receives sample3(firstIndex + i) at position i.
+     */
+    void fill(u32 firstIndex, std::span<vec3<f32>> out) const
+    {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = sample3(firstIndex + static_cast<u32>(i));
+        }
+    }
+
+private:
+    static constexpr f32 radicalInverse(u32 index, u32 base)
+    {
+        // Accumulate the mirrored digits as an integer, then scale once
+        const f64 inverseBase = 1.0 / base;
+        u64 reversed = 0;
+        f64 scale = 1.0;
+        while (index != 0) {
+            const u32 next = index / base;
+            reversed = reversed * base + (index - next * base);
+            scale *= inverseBase;
+            index = next;
+        }
+        const f64 value = static_cast<f64>(reversed) * scale;
+        return value < 1.0 ? static_cast<f32>(value) : 0x1.fffffep-1f;
+    }
+};
+
+/**
+ * @brief Roberts' R sequence, an additive recurrence on the generalized golden ratio.
+ *
+ * Sample n is the fractional part of 0.5 + n * alpha, with alpha built from the plastic number
+ * in 2D and its 3D analogue, which gives the most even additive recurrence known in those
+ * dimensions. It is the cheapest sequence here, a multiply and add per coordinate in 64-bit
+ * fixed point, and has no preferred sample counts.
+ *
+ * Example usage:
+ * @code
+ * const qm::R2Sequence r2;
+ * vec2f jitter = r2.sample2(frameIndex);
+ * @endcode
+ */
+class R2Sequence {
+public:
+    /**
+     * @brief Returns a 2D sample.
+     */
+    constexpr vec2<f32> sample2(u64 index) const
+    {
+        return {toFloat(Offset + index * Alpha2[0]), toFloat(Offset + index * Alpha2[1])};
+    }
+
+    /**
+     * @brief Returns a 3D sample, using the three-dimensional recurrence.
+     */
+    constexpr vec3<f32> sample3(u64 index) const
+    {
+        return {toFloat(Offset + index * Alpha3[0]), toFloat(Offset + index * Alpha3[1]),
+                toFloat(Offset + index * Alpha3[2])};
+    }
+
+    /**
+     * @brief Fills a span with consecutive 2D samples.
+     * @param firstIndex Index of out[0].
+     * @param out Receives sample2(firstIndex + i) at position i.
+     */
+    void fill(u64 firstIndex, std::span<vec2<f32>> out) const
+    {
+        // Step the fixed-point fractions instead of multiplying
+        u64 x = Offset + firstIndex * Alpha2[0];
+        u64 y = Offset + firstIndex * Alpha2[1];
+        for (vec2<f32> &sample : out) {
+            sample = {toFloat(x), toFloat(y)};
+            x += Alpha2[0];
+            y += Alpha2[1];
+        }
+    }
+
+    /**
+     * @brief Fills a span with consecutive 3D samples.
+     * @param firstIndex Index of out[0].
+     * @param out Receives sample3(firstIndex + i) at position i.
+     */
+    void fill(u64 firstIndex, std::span<vec3<f32>> out) const
+    {
+        u64 x = Offset + firstIndex * Alpha3[0];
+        u64 y = Offset + firstIndex * Alpha3[1];
+        u64 z = Offset + firstIndex * Alpha3[2];
+        for (vec3<f32> &sample : out) {
+            sample = {toFloat(x), toFloat(y), toFloat(z)};
+            x += Alpha3[0];
+            y += Alpha3[1];
+            z += Alpha3[2];
+        }
+    }
+
+private:
+    // Powers of the reciprocal generalized golden ratio as 0.64 fixed-point fractions
+    static constexpr u64 Alpha2[2] = {0xc13fa9a902a6328fULL, 0x91e10da5c79e7b1cULL};
+    static constexpr u64 Alpha3[3] = {0xd1b54a32d192ed03ULL, 0xabc98388fb8fac02ULL,
+                                      0x8cb92ba72f3d8dd7ULL};
+    static constexpr u64 Offset = 0x8000000000000000ULL;
+
+    static constexpr f32 toFloat(u64 fraction)
+    {
+        return detail::unitFloat(static_cast<u32>(fraction >> 32));
+    }
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_SEQUENCE_HPP
@@ -0,0 +1,572 @@
+#ifndef QUIKMAFF_SPLINE_HPP
+#define QUIKMAFF_SPLINE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "functions.hpp"
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+/**
+ * Bezier curves and cubic splines over vec2 and vec3.
+ *
+ * Every spline segment is converted to a cubic Bezier, so flattening, uniform sampling and
+ * arc-length tables are written once against CubicBezier. Uniform sampling uses forward
+ * differencing: after a short setup each further sample costs three vector additions, instead
+ * of the full polynomial or a de Casteljau pass per sample.
+ */
+
+namespace qm {
+
+namespace detail {
+
+template <typename VecT>
+using SplineScalar = decltype(VecT::x);
+
+// Deepest subdivision when flattening; 2^16 pieces is far beyond any sensible tolerance.
+constexpr u32 MaxFlattenDepth = 16;
+
+} // namespace detail
+
+/**
+ * @brief A cubic Bezier curve.
+ * @tparam VecT The point type, vec2 or vec3 of a floating-point type.
+ *
+ * Example usage:
+ * @code
+ * qm::CubicBezier<vec2f> curve{{0.0f, 0.0f}, {1.0f, 2.0f}, {3.0f, 2.0f}, {4.0f, 0.0f}};
+ * std::vector<vec2f> polyline;
+ * curve.flatten(0.01f, polyline);
+ * @endcode
+ */
+template <typename VecT>
+struct CubicBezier {
+    using Scalar = detail::SplineScalar<VecT>;
+
+    VecT p0; ///< Start point
+    VecT p1; ///< First control point
+    VecT p2; ///< Second control point
+    VecT p3; ///< End point
+
+    /**
+     * @brief Returns the largest valid parameter, 1.
+     */
+    static constexpr Scalar maxParameter() { return static_cast<Scalar>(1); }
+
+    /**
+     * @brief Evaluates the curve.
+     * @param t The parameter in [0, 1].
+     * @return The point at t.
+     */
+    constexpr VecT evaluate(Scalar t) const
+    {
+        const Scalar mt = static_cast<Scalar>(1) - t;
+        return p0 * (mt * mt * mt) + p1 * (3 * mt * mt * t) + p2 * (3 * mt * t * t) +
+               p3 * (t * t * t);
+    }
+
+    /**
+     * @brief Evaluates the first derivative of the curve.
+     * @param t The parameter in [0, 1].
+     * @return The unnormalized tangent at t.
+     */
+    constexpr VecT tangent(Scalar t) const
+    {
+        const Scalar mt = static_cast<Scalar>(1) - t;
+        return (p1 - p0) * (3 * mt * mt) + (p2 - p1) * (6 * mt * t) + (p3 - p2) * (3 * t * t);
+    }
+
+    /**
+     * @brief Splits the curve in two with de Casteljau's algorithm.
+     * @param t The parameter to split at.
+     * @param left Receives the part over [0, t].
+     * @param right Receives the part over [t, 1].
+     */
+    constexpr void split(Scalar t, CubicBezier &left, CubicBezier &right) const
+    {
+        const VecT p01 = lerp(p0, p1, t);
+        const VecT p12 = lerp(p1, p2, t);
+        const VecT p23 = lerp(p2, p3, t);
+        const VecT p012 = lerp(p01, p12, t);
+        const VecT p123 = lerp(p12, p23, t);
+        const VecT mid = lerp(p012, p123, t);
+        left = {p0, p01, p012, mid};
+        right = {mid, p123, p23, p3};
+    }
+
+    /**
+     * @brief Tests whether the curve lies within a distance of its chord.
+     *
+     * Uses a conservative bound on the distance from the control polygon, so a curve may be
+     * reported as not flat when it is.
+     */
+    constexpr bool isFlat(Scalar tolerance) const
+    {
+        const VecT u = p1 * 3 - p0 * 2 - p3;
+        const VecT v = p2 * 3 - p0 - p3 * 2;
+        Scalar deviation = 0;
+        for (u32 i = 0; i < VecT::componentCount(); ++i) {
+            deviation += qm::max(u[i] * u[i], v[i] * v[i]);
+        }
+        return deviation <= 16 * tolerance * tolerance;
+    }
+
+    /**
+     * @brief Appends a polyline approximating the curve, subdividing only where it bends.
+     * @param tolerance Maximum distance between the curve and the polyline.
+     * @param out The polyline is appended to this vector.
+     * @param includeStart Whether to append p0 first. Pass false when continuing a polyline that
+     * already ends at p0.
+     */
+    void flatten(Scalar tolerance, std::vector<VecT> &out, bool includeStart = true) const
+    {
+        if (includeStart) {
+            out.push_back(p0);
+        }
+
+        // Depth-first over the pieces, left before right, so points come out in order
+        CubicBezier stack[detail::MaxFlattenDepth + 1];
+        u32 depths[detail::MaxFlattenDepth + 1];
+        stack[0] = *this;
+        depths[0] = 0;
+        u32 top = 1;
+        while (top > 0) {
+            --top;
+            const CubicBezier piece = stack[top];
+            const u32 depth = depths[top];
+            if (depth >= detail::MaxFlattenDepth || piece.isFlat(tolerance)) {
+                out.push_back(piece.p3);
+                continue;
+            }
+            piece.split(static_cast<Scalar>(0.5), stack[top + 1], stack[top]);
+            depths[top] = depth + 1;
+            depths[top + 1] = depth + 1;
+            top += 2;
+        }
+    }
+
+    /**
+     * @brief Evaluates the curve at evenly spaced parameters by forward differencing.
+     * @param out Receives out.size() points, from p0 at t = 0 to p3 at t = 1.
+     */
+    constexpr void sample(std::span<VecT> out) const
+    {
+        if (out.empty()) {
+            return;
+        }
+        if (out.size() == 1) {
+            out[0] = p0;
+            return;
+        }
+
+        // Power basis a t^3 + b t^2 + c t + d and its differences for step h
+        const Scalar h = static_cast<Scalar>(1) / static_cast<Scalar>(out.size() - 1);
+        const VecT a = p3 - p0 + (p1 - p2) * 3;
+        const VecT b = (p0 - p1 * 2 + p2) * 3;
+        const VecT c = (p1 - p0) * 3;
+        VecT point = p0;
+        VecT d1 = a * (h * h * h) + b * (h * h) + c * h;
+        VecT d2 = a * (6 * h * h * h) + b * (2 * h * h);
+        const VecT d3 = a * (6 * h * h * h);
+
+        for (std::size_t i = 0; i + 1 < out.size(); ++i) {
+            out[i] = point;
+            point = point + d1;
+            d1 = d1 + d2;
+            d2 = d2 + d3;
+        }
+        out[out.size() - 1] = p3;
+    }
+};
+
+/**
+ * @brief A quadratic Bezier curve.
+ * @tparam VecT The point type, vec2 or vec3 of a floating-point type.
+ *
+ * Example usage:
+ * @code
+ * qm::QuadraticBezier<vec2f> curve{{0.0f, 0.0f}, {1.0f, 2.0f}, {2.0f, 0.0f}};
+ * vec2f top = curve.evaluate(0.5f); // (1, 1)
+ * @endcode
+ */
+template <typename VecT>
+struct QuadraticBezier {
+    using Scalar = detail::SplineScalar<VecT>;
+
+    VecT p0; ///< Start point
+    VecT p1; ///< Control point
+    VecT p2; ///< End point
+
+    /**
+     * @brief Returns the largest valid parameter, 1.
+     */
+    static constexpr Scalar maxParameter() { return static_cast<Scalar>(1); }
+
+    /**
+     * @brief Evaluates the curve.
+     * @param t The parameter in [0, 1].
+     * @return The point at t.
+     */
+    constexpr VecT evaluate(Scalar t) const
+    {
+        const Scalar mt = static_cast<Scalar>(1) - t;
+        return p0 * (mt * mt) + p1 * (2 * mt * t) + p2 * (t * t);
+    }
+
+    /**
+     * @brief Evaluates the first derivative of the curve.
+     * @param t The parameter in [0, 1].
+     * @return The unnormalized tangent at t.
+     */
+    constexpr VecT tangent(Scalar t) const
+    {
+        return (p1 - p0) * (2 * (static_cast<Scalar>(1) - t)) + (p2 - p1) * (2 * t);
+    }
+
+    /**
+     * @brief Splits the curve in two with de Casteljau's algorithm.
+     * @param t The parameter to split at.
+     * @param left Receives the part over [0, t].
+     * @param right Receives the part over [t, 1].
+     */
+    constexpr void split(Scalar t, QuadraticBezier &left, QuadraticBezier &right) const
+    {
+        const VecT p01 = lerp(p0, p1, t);
+        const VecT p12 = lerp(p1, p2, t);
+        const VecT mid = lerp(p01, p12, t);
+        left = {p0, p01, mid};
+        right = {mid, p12, p2};
+    }
+
+    /**
+     * @brief Returns the same curve as a cubic Bezier.
+     */
+    constexpr CubicBezier<VecT> toCubic() const
+    {
+        const Scalar twoThirds = static_cast<Scalar>(2) / static_cast<Scalar>(3);
+        return {p0, lerp(p0, p1, twoThirds), lerp(p2, p1, twoThirds), p2};
+    }
+
+    /**
+     * @brief Appends a polyline approximating the curve, subdividing only where it bends.
+     * @param tolerance Maximum distance between the curve and the polyline.
+     * @param out The polyline is appended to this vector.
+     * @param includeStart Whether to append p0 first.
+     */
+    void flatten(Scalar tolerance, std::vector<VecT> &out, bool includeStart = true) const
+    {
+        toCubic().flatten(tolerance, out, includeStart);
+    }
+
+    /**
+     * @brief Evaluates the curve at evenly spaced parameters by forward differencing.
+     * @param out Receives out.size() points, from p0 at t = 0 to p2 at t = 1.
+     */
+    constexpr void sample(std::span<VecT> out) const
+    {
+        if (out.empty()) {
+            return;
+        }
+        if (out.size() == 1) {
+            out[0] = p0;
+            return;
+        }
+
+        // Power basis a t^2 + b t + c and its differences for step h
+        const Scalar h = static_cast<Scalar>(1) / static_cast<Scalar>(out.size() - 1);
+        const VecT a = p0 - p1 * 2 + p2;
+        const VecT b = (p1 - p0) * 2;
+        VecT point = p0;
+        VecT d1 = a * (h * h) + b * h;
+        const VecT d2 = a * (2 * h * h);
+
+        for (std::size_t i = 0; i + 1 < out.size(); ++i) {
+            out[i] = point;
+            point = point + d1;
+            d1 = d1 + d2;
+        }
+        out[out.size() - 1] = p2;
+    }
+};
+
+namespace detail {
+
+// Evaluation shared by the piecewise cubic splines, which provide segmentCount() and segment(i)
+// converting a span to a cubic Bezier. The global parameter runs from 0 to segmentCount(), one
+// unit per segment; the constructors guarantee at least one segment.
+template <typename Derived, typename VecT>
+class PiecewiseCubic {
+public:
+    using Scalar = SplineScalar<VecT>;
+
+    /**
+     * @brief Returns the largest valid parameter, the number of segments.
+     */
+    Scalar maxParameter() const { return static_cast<Scalar>(self().segmentCount()); }
+
+    /**
+     * @brief Evaluates the spline.
+     * @param t The parameter in [0, segmentCount()].
+     * @return The point at t.
+     */
+    VecT evaluate(Scalar t) const
+    {
+        Scalar local;
+        return self().segment(locate(t, local)).evaluate(local);
+    }
+
+    /**
+     * @brief Evaluates the first derivative of the spline with respect to its parameter.
+     * @param t The parameter in [0, segmentCount()].
+     * @return The unnormalized tangent at t.
+     */
+    VecT tangent(Scalar t) const
+    {
+        Scalar local;
+        return self().segment(locate(t, local)).tangent(local);
+    }
+
+    /**
+     * @brief Appends a polyline approximating the whole spline.
+     * @param tolerance Maximum distance between the spline and the polyline.
+     * @param out The polyline is appended to this vector.
+     */
+    void flatten(Scalar tolerance, std::vector<VecT> &out) const
+    {
+        for (std::size_t i = 0; i < self().segmentCount(); ++i) {
+            self().segment(i).flatten(tolerance, out, i == 0);
+        }
+    }
+
+    /**
+     * @brief Evaluates the spline at evenly spaced parameters in every segment by forward
+     * differencing.
+     * @param samplesPerSegment Number of steps per segment.
+     * @param out Receives segmentCount() * samplesPerSegment + 1 points.
+     */
+    void sample(u32 samplesPerSegment, std::span<VecT> out) const
+    {
+        const std::size_t segments = self().segmentCount();
+        QM_ASSERT(samplesPerSegment > 0 && out.size() >= segments * samplesPerSegment + 1);
+        for (std::size_t i = 0; i < segments; ++i) {
+            // Adjacent segments share their end points, so each overwrites the previous end
+            self().segment(i).sample(out.subspan(i * samplesPerSegment, samplesPerSegment + 1));
+        }
+    }
+
+private:
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+    std::size_t locate(Scalar t, Scalar &local) const
+    {
+        const std::size_t segments = self().segmentCount();
+        QM_ASSERT(segments > 0);
+        const Scalar clamped = qm::clamp(t, static_cast<Scalar>(0), static_cast<Scalar>(segments));
+        const std::size_t index = qm::min(static_cast<std::size_t>(clamped), segments - 1);
+        local = clamped - static_cast<Scalar>(index);
+        return index;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A uniform Catmull-Rom spline, passing through every control point.
+ *
+ * The curve leaves the first point and arrives at the last one as if mirrored control points
+ * continued the polygon beyond them. The spline views the points; they must outlive it.
+ *
+ * @tparam VecT The point type, vec2 or vec3 of a floating-point type.
+ *
+ * Example usage:
+ * @code
+ * qm::CatmullRomSpline<vec3f> rail(waypoints);
+ * vec3f position = rail.evaluate(elapsed * speed);
+ * @endcode
+ */
+template <typename VecT>
+class CatmullRomSpline : public detail::PiecewiseCubic<CatmullRomSpline<VecT>, VecT> {
+public:
+    /**
+     * @brief Constructs a spline through the given points.
+     * @param points The control points; at least two, or it throws an invalid_argument exception.
+     */
+    explicit CatmullRomSpline(std::span<const VecT> points) : m_points{points}
+    {
+        if (points.size() < 2) {
+            throw std::invalid_argument("CatmullRomSpline needs at least two points");
+        }
+    }
+
+    /**
+     * @brief Returns the number of segments, one between each pair of points.
+     */
+    std::size_t segmentCount() const { return m_points.size() - 1; }
+
+    /**
+     * @brief Returns the segment from point i to point i + 1 as a cubic Bezier.
+     */
+    CubicBezier<VecT> segment(std::size_t i) const
+    {
+        const std::size_t last = m_points.size() - 1;
+        const VecT &p1 = m_points[i];
+        const VecT &p2 = m_points[i + 1];
+        const VecT p0 = i > 0 ? m_points[i - 1] : p1 * 2 - p2;
+        const VecT p3 = i + 1 < last ? m_points[i + 2] : p2 * 2 - p1;
+        return {p1, p1 + (p2 - p0) / 6, p2 - (p3 - p1) / 6, p2};
+    }
+
+private:
+    std::span<const VecT> m_points;
+};
+
+/**
+ * @brief A uniform cubic B-spline.
+ *
+ * The curve is C2 continuous and stays within the convex hull of its control points, but does
+ * not pass through them. The spline views the points; they must outlive it.
+ *
+ * @tparam VecT The point type, vec2 or vec3 of a floating-point type.
+ *
+ * Example usage:
+ * @code
+ * qm::BSpline<vec2f> spline(controlPoints);
+ * std::vector<vec2f> polyline;
+ * spline.flatten(0.05f, polyline);
+ * @endcode
+ */
+template <typename VecT>
+class BSpline : public detail::PiecewiseCubic<BSpline<VecT>, VecT> {
+public:
+    /**
+     * @brief Constructs a spline from control points.
+     * @param points The control points; at least four, or it throws an invalid_argument exception.
+     */
+    explicit BSpline(std::span<const VecT> points) : m_points{points}
+    {
+        if (points.size() < 4) {
+            throw std::invalid_argument("BSpline needs at least four control points");
+        }
+    }
+
+    /**
+     * @brief Returns the number of segments, one per four consecutive control points.
+     */
+    std::size_t segmentCount() const { return m_points.size() - 3; }
+
+    /**
+     * @brief Returns the segment shaped by points i to i + 3 as a cubic Bezier.
+     */
+    CubicBezier<VecT> segment(std::size_t i) const
+    {
+        const VecT &p0 = m_points[i];
+        const VecT &p1 = m_points[i + 1];
+        const VecT &p2 = m_points[i + 2];
+        const VecT &p3 = m_points[i + 3];
+        return {(p0 + p1 * 4 + p2) / 6, (p1 * 2 + p2) / 3, (p1 + p2 * 2) / 3,
+                (p1 + p2 * 4 + p3) / 6};
+    }
+
+private:
+    std::span<const VecT> m_points;
+};
+
+/**
+ * @brief A table mapping arc length to curve parameter.
+ *
+ * Moving at constant speed along a curve needs the parameter at a given distance, which has no
+ * closed form. The table samples the curve once at evenly spaced parameters and stores the
+ * cumulative chord lengths; lookups are then a binary search and a linear interpolation.
+ *
+ * @tparam T The floating-point type of distances and parameters.
+ *
+ * Example usage:
+ * @code
+ * qm::ArcLengthTable<f32> table;
+ * table.build(rail, 32);
+ * vec3f position = rail.evaluate(table.parameterAt(distanceTravelled));
+ * @endcode
+ */
+template <IsFloatingPointT T>
+class ArcLengthTable {
+public:
+    /**
+     * @brief Samples a curve into the table.
+     * @param curve Any curve in this file, or anything else with evaluate(t) and maxParameter().
+     * @param samplesPerUnit Number of chords per unit of parameter, so per segment of a spline.
+     */
+    template <typename CurveT>
+    void build(const CurveT &curve, u32 samplesPerUnit = 32)
+    {
+        m_maxParameter = static_cast<T>(curve.maxParameter());
+        const T sampleCount = std::ceil(m_maxParameter * static_cast<T>(samplesPerUnit));
+        const std::size_t samples = qm::max<std::size_t>(1, static_cast<std::size_t>(sampleCount));
+        m_lengths.resize(samples + 1);
+
+        auto previous = curve.evaluate(0);
+        m_lengths[0] = 0;
+        for (std::size_t i = 1; i <= samples; ++i) {
+            const auto point = curve.evaluate(
+                m_maxParameter * static_cast<T>(i) / static_cast<T>(samples));
+            m_lengths[i] = m_lengths[i - 1] + static_cast<T>((point - previous).length());
+            previous = point;
+        }
+    }
+
+    /**
+     * @brief Returns the total length of the curve.
+     */
+    T length() const { return m_lengths.empty() ? static_cast<T>(0) : m_lengths.back(); }
+
+    /**
+     * @brief Returns the parameter at a distance along the curve.
+     * @param distance The distance from the start, clamped to [0, length()].
+     */
+    T parameterAt(T distance) const
+    {
+        if (m_lengths.size() < 2 || distance <= 0) {
+            return 0;
+        }
+        if (distance >= m_lengths.back()) {
+            return m_maxParameter;
+        }
+
+        const auto upper = std::upper_bound(m_lengths.begin(), m_lengths.end(), distance);
+        const std::size_t i = static_cast<std::size_t>(upper - m_lengths.begin()) - 1;
+        const T span = m_lengths[i + 1] - m_lengths[i];
+        const T fraction = span > 0 ? (distance - m_lengths[i]) / span : static_cast<T>(0);
+        return (static_cast<T>(i) + fraction) * step();
+    }
+
+    /**
+     * @brief Returns the distance along the curve at a parameter.
+     * @param t The parameter, clamped to the curve's range.
+     */
+    T distanceAt(T t) const
+    {
+        if (m_lengths.size() < 2 || t <= 0) {
+            return 0;
+        }
+        if (t >= m_maxParameter) {
+            return m_lengths.back();
+        }
+
+        const T position = t / step();
+        const std::size_t i = qm::min(static_cast<std::size_t>(position), m_lengths.size() - 2);
+        return lerp(m_lengths[i], m_lengths[i + 1], position - static_cast<T>(i));
+    }
+
+private:
+    T step() const { return m_maxParameter / static_cast<T>(m_lengths.size() - 1); }
+
+    std::vector<T> m_lengths;
+    T m_maxParameter = 0;
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_SPLINE_HPP
@@ -0,0 +1,714 @@
+#ifndef QUIKMAFF_TRIANGULATE_HPP
+#define QUIKMAFF_TRIANGULATE_HPP
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "morton.hpp"
+#include "predicates.hpp"
+#include "vec2.hpp"
+
+namespace qm {
+
+/**
+ * @brief Triangulates simple polygons with holes by ear clipping.
+ *
+ * The outer contour and the holes are linked into a single ring by bridging each hole, from its
+ * leftmost vertex, to a visible vertex of the outer contour. Ears are then clipped from the
+ * ring. Testing a candidate ear means finding reflex vertices inside it; for polygons with more
+ * than 80 vertices the vertices are also kept in a list sorted by Morton key, so only those
+ * whose key falls in the range of the ear's bounding box are visited and the work stays close
+ * to linear. Rings that get stuck are filtered of degenerate vertices, cured of local
+ * self-intersections and finally split along a valid diagonal, so malformed input still
+ * produces a reasonable triangulation.
+ *
+ * All orientation decisions use the exact predicates. The internal buffers are kept between
+ * calls, so a triangulator reused for many polygons only allocates while they grow to the
+ * largest input seen.
+ *
+ * @tparam T The floating-point type of the points.
+ *
+ * Example usage:
+ * @code
+ * qm::EarClipper<f32> clipper;
+ * std::vector<u32> indices(3 * clipper.maxTriangles(points.size(), holeCount));
+ * indices.resize(3 * clipper.triangulate(points, contourOffsets, indices));
+ * @endcode
+ */
+template <IsFloatingPointT T>
+class EarClipper {
+public:
+    /**
+     * @brief Returns the most triangles a polygon can produce.
+     * @param pointCount Number of vertices over all contours.
+     * @param holeCount Number of holes.
+     */
+    static constexpr std::size_t maxTriangles(std::size_t pointCount, std::size_t holeCount)
+    {
+        return pointCount + 2 * holeCount >= 2 ? pointCount + 2 * holeCount - 2 : 0;
+    }
+
+    /**
+     * @brief Triangulates a polygon.
+     * @param points Vertices of every contour. The first contour is the outer boundary and any
+     * others are holes; either winding is accepted for each.
+     * @param contourOffsets Start offset of each contour into points, followed by
+     * points.size(); empty when the polygon is a single contour.
+     * @param outIndices Receives three point indices per counter-clockwise triangle. Triangles
+     * beyond the buffer's capacity are counted but not written; see maxTriangles().
+     * @return The number of triangles.
+     */
+    std::size_t triangulate(std::span<const vec2<T>> points, std::span<const u32> contourOffsets,
+                            std::span<u32> outIndices)
+    {
+        m_nodes.clear();
+        m_out = outIndices;
+        m_triangleCount = 0;
+
+        const std::size_t contourCount =
+            contourOffsets.empty() ? (points.empty() ? 0 : 1) : contourOffsets.size() - 1;
+        if (contourCount == 0) {
+            return 0;
+        }
+        auto contourBegin = [&](std::size_t i) {
+            return contourOffsets.empty() ? 0u : contourOffsets[i];
+        };
+        auto contourEnd = [&](std::size_t i) {
+            return contourOffsets.empty() ? static_cast<u32>(points.size())
+                                          : contourOffsets[i + 1];
+        };
+
+        // Bridging adds two vertices per hole and splitting two per diagonal
+        m_nodes.reserve(points.size() + points.size() / 2 + 2 * contourCount);
+
+        u32 outer = linkContour(points, contourBegin(0), contourEnd(0), true);
+        if (outer == None || m_nodes[outer].Next == m_nodes[outer].Prev) {
+            return 0;
+        }
+
+        if (contourCount > 1) {
+            m_holes.clear();
+            for (std::size_t i = 1; i < contourCount; ++i) {
+                const u32 hole = linkContour(points, contourBegin(i), contourEnd(i), false);
+                if (hole == None) {
+                    continue;
+                }
+                if (m_nodes[hole].Next == hole) {
+                    m_nodes[hole].Steiner = true;
+                }
+                m_holes.push_back(leftmost(hole));
+            }
+
+            // Bridge holes from left to right, so each bridge only sees holes already merged
+            std::sort(m_holes.begin(), m_holes.end(), [&](u32 a, u32 b) {
+                const Node &na = m_nodes[a];
+                const Node &nb = m_nodes[b];
+                if (na.X != nb.X) {
+                    return na.X < nb.X;
+                }
+                if (na.Y != nb.Y) {
+                    return na.Y < nb.Y;
+                }
+                return slope(a) < slope(b);
+            });
+            for (const u32 hole : m_holes) {
+                outer = eliminateHole(hole, outer);
+            }
+        }
+
+        // Hash vertices along a Morton curve when the polygon is large enough to benefit
+        m_invSize = 0;
+        if (points.size() > 80) {
+            T minX = points[0].x;
+            T minY = points[0].y;
+            T maxX = minX;
+            T maxY = minY;
+            for (const vec2<T> &p : points) {
+                minX = std::min(minX, p.x);
+                minY = std::min(minY, p.y);
+                maxX = std::max(maxX, p.x);
+                maxY = std::max(maxY, p.y);
+            }
+            const f64 size = std::max(static_cast<f64>(maxX) - minX, static_cast<f64>(maxY) - minY);
+            m_minX = minX;
+            m_minY = minY;
+            m_invSize = size > 0.0 ? 65535.0 / size : 0.0;
+        }
+
+        clipEars(outer, 0);
+        return m_triangleCount;
+    }
+
+private:
+    static constexpr u32 None = 0xFFFFFFFFu;
+
+    struct Node {
+        T X;
+        T Y;
+        u32 Index; // Point index in the input
+        u32 Prev;
+        u32 Next;
+        u64 Z;     // Morton key, 0 until hashed
+        u32 PrevZ; // Neighbours in Morton order
+        u32 NextZ;
+        bool Steiner; // Single-point holes, kept by filterPoints
+    };
+
+    f64 orient(u32 a, u32 b, u32 c) const
+    {
+        const Node &na = m_nodes[a];
+        const Node &nb = m_nodes[b];
+        const Node &nc = m_nodes[c];
+        return orient2d(static_cast<f64>(na.X), static_cast<f64>(na.Y), static_cast<f64>(nb.X),
+                        static_cast<f64>(nb.Y), static_cast<f64>(nc.X), static_cast<f64>(nc.Y));
+    }
+
+    bool equals(u32 a, u32 b) const
+    {
+        return m_nodes[a].X == m_nodes[b].X && m_nodes[a].Y == m_nodes[b].Y;
+    }
+
+    // Whether p lies in or on the counter-clockwise triangle abc
+    bool pointInTriangle(f64 ax, f64 ay, f64 bx, f64 by, f64 cx, f64 cy, f64 px, f64 py) const
+    {
+        return orient2d(ax, ay, bx, by, px, py) >= 0.0 && orient2d(bx, by, cx, cy, px, py) >= 0.0 &&
+               orient2d(cx, cy, ax, ay, px, py) >= 0.0;
+    }
+
+    bool pointInTriangle(u32 a, u32 b, u32 c, u32 p) const
+    {
+        const Node &na = m_nodes[a];
+        const Node &nb = m_nodes[b];
+        const Node &nc = m_nodes[c];
+        const Node &np = m_nodes[p];
+        return pointInTriangle(na.X, na.Y, nb.X, nb.Y, nc.X, nc.Y, np.X, np.Y);
+    }
+
+    // Slope of the edge leaving a vertex, used to order holes sharing a leftmost point
+    f64 slope(u32 node) const
+    {
+        const Node &a = m_nodes[node];
+        const Node &b = m_nodes[a.Next];
+        const f64 dx = static_cast<f64>(b.X) - a.X;
+        const f64 dy = static_cast<f64>(b.Y) - a.Y;
+        return dx != 0.0 ? dy / dx : (dy > 0.0 ? HUGE_VAL : (dy < 0.0 ? -HUGE_VAL : 0.0));
+    }
+
+    u32 createNode(u32 index, T x, T y)
+    {
+        const u32 id = static_cast<u32>(m_nodes.size());
+        m_nodes.push_back({x, y, index, id, id, 0, None, None, false});
+        return id;
+    }
+
+    void link(u32 from, u32 to)
+    {
+        m_nodes[from].Next = to;
+        m_nodes[to].Prev = from;
+    }
+
+    void removeNode(u32 node)
+    {
+        const Node &n = m_nodes[node];
+        link(n.Prev, n.Next);
+        if (n.PrevZ != None) {
+            m_nodes[n.PrevZ].NextZ = n.NextZ;
+        }
+        if (n.NextZ != None) {
+            m_nodes[n.NextZ].PrevZ = n.PrevZ;
+        }
+    }
+
+    void emit(u32 a, u32 b, u32 c)
+    {
+        if (3 * m_triangleCount + 2 < m_out.size()) {
+            m_out[3 * m_triangleCount] = m_nodes[a].Index;
+            m_out[3 * m_triangleCount + 1] = m_nodes[b].Index;
+            m_out[3 * m_triangleCount + 2] = m_nodes[c].Index;
+        }
+        ++m_triangleCount;
+    }
+
+    // Links a contour into a ring wound counter-clockwise, or clockwise for holes. Returns the
+    // last node, or None if the contour is empty.
+    u32 linkContour(std::span<const vec2<T>> points, u32 begin, u32 end, bool counterClockwise)
+    {
+        if (begin >= end) {
+            return None;
+        }
+
+        f64 area = 0.0;
+        for (u32 i = begin, j = end - 1; i < end; j = i++) {
+            area += static_cast<f64>(points[j].x) * points[i].y -
+                    static_cast<f64>(points[i].x) * points[j].y;
+        }
+
+        u32 last = None;
+        auto insert = [&](u32 i) {
+            const u32 node = createNode(i, points[i].x, points[i].y);
+            if (last != None) {
+                link(node, m_nodes[last].Next);
+                link(last, node);
+            }
+            last = node;
+        };
+        if ((area > 0.0) == counterClockwise) {
+            for (u32 i = begin; i < end; ++i) {
+                insert(i);
+            }
+        }
+        else {
+            for (u32 i = end; i-- > begin;) {
+                insert(i);
+            }
+        }
+
+        if (last != m_nodes[last].Next && equals(last, m_nodes[last].Next)) {
+            const u32 next = m_nodes[last].Next;
+            removeNode(last);
+            last = next;
+        }
+        return last;
+    }
+
+    // Removes duplicate and collinear vertices between start and end, returning a node still in
+    // the ring.
+    u32 filterPoints(u32 start, u32 end = None)
+    {
+        if (start == None) {
+            return start;
+        }
+        if (end == None) {
+            end = start;
+        }
+
+        u32 p = start;
+        bool again;
+        do {
+            again = false;
+            const Node &n = m_nodes[p];
+            if (!n.Steiner && (equals(p, n.Next) || orient(n.Prev, p, n.Next) == 0.0)) {
+                removeNode(p);
+                p = end = n.Prev;
+                if (p == m_nodes[p].Next) {
+                    break;
+                }
+                again = true;
+            }
+            else {
+                p = n.Next;
+            }
+        } while (again || p != end);
+        return end;
+    }
+
+    u32 leftmost(u32 start) const
+    {
+        u32 p = start;
+        u32 best = start;
+        do {
+            const Node &n = m_nodes[p];
+            if (n.X < m_nodes[best].X || (n.X == m_nodes[best].X && n.Y < m_nodes[best].Y)) {
+                best = p;
+            }
+            p = n.Next;
+        } while (p != start);
+        return best;
+    }
+
+    // Joins a hole into the outer ring with a pair of bridge edges.
+    u32 eliminateHole(u32 hole, u32 outer)
+    {
+        const u32 bridge = findHoleBridge(hole, outer);
+        if (bridge == None) {
+            return outer;
+        }
+        const u32 bridgeReverse = splitPolygon(bridge, hole);
+        filterPoints(bridgeReverse, m_nodes[bridgeReverse].Next);
+        return filterPoints(bridge, m_nodes[bridge].Next);
+    }
+
+    // Finds an outer vertex visible from the hole's leftmost vertex, by casting a ray to the
+    // left and, if the closest edge hit is partly hidden, taking the reflex vertex inside the
+    // hidden region with the smallest angle to the ray.
+    u32 findHoleBridge(u32 hole, u32 outer) const
+    {
+        const f64 hx = m_nodes[hole].X;
+        const f64 hy = m_nodes[hole].Y;
+        f64 qx = -HUGE_VAL;
+        u32 m = None;
+
+        u32 p = outer;
+        if (equals(hole, p)) {
+            return p;
+        }
+        do {
+            const Node &n = m_nodes[p];
+            const Node &next = m_nodes[n.Next];
+            if (equals(hole, n.Next)) {
+                return n.Next;
+            }
+            if (hy <= n.Y && hy >= next.Y && next.Y != n.Y) {
+                const f64 x = n.X + (hy - n.Y) * (static_cast<f64>(next.X) - n.X) /
+                                        (static_cast<f64>(next.Y) - n.Y);
+                if (x <= hx && x > qx) {
+                    qx = x;
+                    m = n.X < next.X ? p : n.Next;
+                    if (x == hx) {
+                        return m; // The hole touches the edge; take its leftmost endpoint
+                    }
+                }
+            }
+            p = n.Next;
+        } while (p != outer);
+
+        if (m == None) {
+            return None;
+        }
+
+        const u32 stop = m;
+        const f64 mx = m_nodes[m].X;
+        const f64 my = m_nodes[m].Y;
+        f64 tanMin = HUGE_VAL;
+        p = m;
+        do {
+            const Node &n = m_nodes[p];
+            if (hx >= n.X && n.X >= mx && hx != n.X &&
+                pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, n.X, n.Y)) {
+                const f64 tan = std::abs(hy - n.Y) / (hx - n.X);
+                const bool better =
+                    tan < tanMin ||
+                    (tan == tanMin &&
+                     (n.X > m_nodes[m].X || (n.X == m_nodes[m].X && sectorContainsSector(m, p))));
+                if (locallyInside(p, hole) && better) {
+                    m = p;
+                    tanMin = tan;
+                }
+            }
+            p = n.Next;
+        } while (p != stop);
+        return m;
+    }
+
+    // Whether the sector of m contains the sector of p, for bridges to coincident vertices.
+    bool sectorContainsSector(u32 m, u32 p) const
+    {
+        return orient(m_nodes[m].Prev, m, m_nodes[p].Prev) > 0.0 &&
+               orient(m_nodes[p].Next, m, m_nodes[m].Next) > 0.0;
+    }
+
+    // Sorts the ring's vertices into a list by Morton key.
+    void indexCurve(u32 start)
+    {
+        m_order.clear();
+        u32 p = start;
+        do {
+            Node &n = m_nodes[p];
+            if (n.Z == 0) {
+                n.Z = zOrder(n.X, n.Y);
+            }
+            m_order.push_back(p);
+            p = n.Next;
+        } while (p != start);
+
+        std::sort(m_order.begin(), m_order.end(),
+                  [&](u32 a, u32 b) { return m_nodes[a].Z < m_nodes[b].Z; });
+        for (std::size_t i = 0; i < m_order.size(); ++i) {
+            Node &n = m_nodes[m_order[i]];
+            n.PrevZ = i > 0 ? m_order[i - 1] : None;
+            n.NextZ = i + 1 < m_order.size() ? m_order[i + 1] : None;
+        }
+    }
+
+    u64 zOrder(f64 x, f64 y) const
+    {
+        return mortonEncode(vec2<u32>(static_cast<u32>((x - m_minX) * m_invSize),
+                                      static_cast<u32>((y - m_minY) * m_invSize)));
+    }
+
+    // Clips ears from a ring, falling back to the next repair pass whenever a full loop finds
+    // none: 1 filters degenerate vertices, 2 cures local self-intersections and 3 splits the
+    // ring in two.
+    void clipEars(u32 ear, u32 pass)
+    {
+        if (ear == None) {
+            return;
+        }
+        if (pass == 0 && m_invSize != 0.0) {
+            indexCurve(ear);
+        }
+
+        u32 stop = ear;
+        while (m_nodes[ear].Prev != m_nodes[ear].Next) {
+            const u32 prev = m_nodes[ear].Prev;
+            const u32 next = m_nodes[ear].Next;
+
+            if (m_invSize != 0.0 ? isEarHashed(ear) : isEar(ear)) {
+                emit(prev, ear, next);
+                removeNode(ear);
+
+                // Skipping the next vertex leaves fewer slivers
+                ear = m_nodes[next].Next;
+                stop = ear;
+                continue;
+            }
+
+            ear = next;
+            if (ear == stop) {
+                if (pass == 0) {
+                    clipEars(filterPoints(ear), 1);
+                }
+                else if (pass == 1) {
+                    clipEars(cureLocalIntersections(filterPoints(ear)), 2);
+                }
+                else if (pass == 2) {
+                    splitRing(ear);
+                }
+                break;
+            }
+        }
+    }
+
+    // A candidate ear with its bounding box
+    struct Ear {
+        u32 A, B, C;
+        T MinX, MinY, MaxX, MaxY;
+    };
+
+    Ear makeEar(u32 ear) const
+    {
+        const u32 a = m_nodes[ear].Prev;
+        const u32 c = m_nodes[ear].Next;
+        const Node &na = m_nodes[a];
+        const Node &nb = m_nodes[ear];
+        const Node &nc = m_nodes[c];
+        return {a,
+                ear,
+                c,
+                std::min(na.X, std::min(nb.X, nc.X)),
+                std::min(na.Y, std::min(nb.Y, nc.Y)),
+                std::max(na.X, std::max(nb.X, nc.X)),
+                std::max(na.Y, std::max(nb.Y, nc.Y))};
+    }
+
+    // Whether p is a reflex vertex inside the ear. Copies of its first vertex left by bridges do
+    // not count.
+    bool blocksEar(const Ear &ear, u32 p) const
+    {
+        const Node &np = m_nodes[p];
+        return np.X >= ear.MinX && np.X <= ear.MaxX && np.Y >= ear.MinY && np.Y <= ear.MaxY &&
+               !equals(p, ear.A) && pointInTriangle(ear.A, ear.B, ear.C, p) &&
+               orient(np.Prev, p, np.Next) <= 0.0;
+    }
+
+    // An ear is convex with no reflex vertex of the ring inside it.
+    bool isEar(u32 node) const
+    {
+        const Ear ear = makeEar(node);
+        if (orient(ear.A, ear.B, ear.C) <= 0.0) {
+            return false;
+        }
+
+        for (u32 p = m_nodes[ear.C].Next; p != ear.A; p = m_nodes[p].Next) {
+            if (blocksEar(ear, p)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // As isEar, visiting only the vertices whose Morton key lies within the ear's bounding box.
+    bool isEarHashed(u32 node) const
+    {
+        const Ear ear = makeEar(node);
+        if (orient(ear.A, ear.B, ear.C) <= 0.0) {
+            return false;
+        }
+
+        const u64 minZ = zOrder(ear.MinX, ear.MinY);
+        const u64 maxZ = zOrder(ear.MaxX, ear.MaxY);
+        auto blocks = [&](u32 p) { return p != ear.A && p != ear.C && blocksEar(ear, p); };
+
+        // Walk outwards in both directions at once
+        u32 p = m_nodes[node].PrevZ;
+        u32 n = m_nodes[node].NextZ;
+        while (p != None && m_nodes[p].Z >= minZ && n != None && m_nodes[n].Z <= maxZ) {
+            if (blocks(p) || blocks(n)) {
+                return false;
+            }
+            p = m_nodes[p].PrevZ;
+            n = m_nodes[n].NextZ;
+        }
+        for (; p != None && m_nodes[p].Z >= minZ; p = m_nodes[p].PrevZ) {
+            if (blocks(p)) {
+                return false;
+            }
+        }
+        for (; n != None && m_nodes[n].Z <= maxZ; n = m_nodes[n].NextZ) {
+            if (blocks(n)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Clips the triangle of a small self-intersection, where edge (a, p) crosses (p.next, b).
+    u32 cureLocalIntersections(u32 start)
+    {
+        u32 p = start;
+        do {
+            const u32 a = m_nodes[p].Prev;
+            const u32 pNext = m_nodes[p].Next;
+            const u32 b = m_nodes[pNext].Next;
+            if (!equals(a, b) && intersects(a, p, pNext, b) && locallyInside(a, b) &&
+                locallyInside(b, a)) {
+                emit(a, p, b);
+                removeNode(p);
+                removeNode(pNext);
+                p = start = b;
+            }
+            p = m_nodes[p].Next;
+        } while (p != start);
+        return filterPoints(p);
+    }
+
+    // Splits the ring along the first valid diagonal and triangulates both halves.
+    void splitRing(u32 start)
+    {
+        u32 a = start;
+        do {
+            u32 b = m_nodes[m_nodes[a].Next].Next;
+            while (b != m_nodes[a].Prev) {
+                if (m_nodes[a].Index != m_nodes[b].Index && isValidDiagonal(a, b)) {
+                    u32 c = splitPolygon(a, b);
+                    a = filterPoints(a, m_nodes[a].Next);
+                    c = filterPoints(c, m_nodes[c].Next);
+                    clipEars(a, 0);
+                    clipEars(c, 0);
+                    return;
+                }
+                b = m_nodes[b].Next;
+            }
+            a = m_nodes[a].Next;
+        } while (a != start);
+    }
+
+    bool isValidDiagonal(u32 a, u32 b) const
+    {
+        const Node &na = m_nodes[a];
+        const Node &nb = m_nodes[b];
+        if (m_nodes[na.Next].Index == nb.Index || m_nodes[na.Prev].Index == nb.Index ||
+            intersectsPolygon(a, b)) {
+            return false;
+        }
+        // Locally visible without creating opposite-facing sectors, or a zero-length bridge
+        return (locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&
+                (orient(na.Prev, a, nb.Prev) != 0.0 || orient(a, nb.Prev, b) != 0.0)) ||
+               (equals(a, b) && orient(na.Prev, a, na.Next) < 0.0 &&
+                orient(nb.Prev, b, nb.Next) < 0.0);
+    }
+
+    // Whether segments (p1, q1) and (p2, q2) intersect, touching included.
+    bool intersects(u32 p1, u32 q1, u32 p2, u32 q2) const
+    {
+        auto sign = [](f64 value) { return value > 0.0 ? 1 : (value < 0.0 ? -1 : 0); };
+        const int o1 = sign(orient(p1, q1, p2));
+        const int o2 = sign(orient(p1, q1, q2));
+        const int o3 = sign(orient(p2, q2, p1));
+        const int o4 = sign(orient(p2, q2, q1));
+        if (o1 != o2 && o3 != o4) {
+            return true;
+        }
+        return (o1 == 0 && onSegment(p1, p2, q1)) || (o2 == 0 && onSegment(p1, q2, q1)) ||
+               (o3 == 0 && onSegment(p2, p1, q2)) || (o4 == 0 && onSegment(p2, q1, q2));
+    }
+
+    // For collinear p, q, r: whether q lies within the bounds of segment (p, r).
+    bool onSegment(u32 p, u32 q, u32 r) const
+    {
+        const Node &np = m_nodes[p];
+        const Node &nq = m_nodes[q];
+        const Node &nr = m_nodes[r];
+        return nq.X <= std::max(np.X, nr.X) && nq.X >= std::min(np.X, nr.X) &&
+               nq.Y <= std::max(np.Y, nr.Y) && nq.Y >= std::min(np.Y, nr.Y);
+    }
+
+    bool intersectsPolygon(u32 a, u32 b) const
+    {
+        const u32 ia = m_nodes[a].Index;
+        const u32 ib = m_nodes[b].Index;
+        u32 p = a;
+        do {
+            const u32 next = m_nodes[p].Next;
+            const u32 ip = m_nodes[p].Index;
+            const u32 inext = m_nodes[next].Index;
+            if (ip != ia && inext != ia && ip != ib && inext != ib && intersects(p, next, a, b)) {
+                return true;
+            }
+            p = next;
+        } while (p != a);
+        return false;
+    }
+
+    // Whether the diagonal (a, b) starts into the polygon's interior at a.
+    bool locallyInside(u32 a, u32 b) const
+    {
+        const u32 prev = m_nodes[a].Prev;
+        const u32 next = m_nodes[a].Next;
+        if (orient(prev, a, next) > 0.0) {
+            return orient(a, b, next) <= 0.0 && orient(a, prev, b) <= 0.0;
+        }
+        return orient(a, b, prev) > 0.0 || orient(a, next, b) > 0.0;
+    }
+
+    // Whether the midpoint of the diagonal (a, b) lies inside the ring.
+    bool middleInside(u32 a, u32 b) const
+    {
+        const f64 px = (static_cast<f64>(m_nodes[a].X) + m_nodes[b].X) / 2.0;
+        const f64 py = (static_cast<f64>(m_nodes[a].Y) + m_nodes[b].Y) / 2.0;
+        bool inside = false;
+        u32 p = a;
+        do {
+            const Node &n = m_nodes[p];
+            const Node &next = m_nodes[n.Next];
+            if ((n.Y > py) != (next.Y > py) && next.Y != n.Y &&
+                px < (static_cast<f64>(next.X) - n.X) * (py - n.Y) /
+                             (static_cast<f64>(next.Y) - n.Y) +
+                         n.X) {
+                inside = !inside;
+            }
+            p = n.Next;
+        } while (p != a);
+        return inside;
+    }
+
+    // Cuts the ring along the diagonal (a, b) into two, duplicating both vertices. Returns the
+    // copy of b, which is in the ring that does not contain a.
+    u32 splitPolygon(u32 a, u32 b)
+    {
+        const u32 a2 = createNode(m_nodes[a].Index, m_nodes[a].X, m_nodes[a].Y);
+        const u32 b2 = createNode(m_nodes[b].Index, m_nodes[b].X, m_nodes[b].Y);
+        const u32 aNext = m_nodes[a].Next;
+        const u32 bPrev = m_nodes[b].Prev;
+        link(a, b);
+        link(a2, aNext);
+        link(b2, a2);
+        link(bPrev, b2);
+        return b2;
+    }
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<u32> m_holes;
+    std::vector<u32> m_order;
+    std::span<u32> m_out;
+    std::size_t m_triangleCount = 0;
+    f64 m_minX = 0.0;
+    f64 m_minY = 0.0;
+    f64 m_invSize = 0.0;
+};
+
+} // namespace qm
+
+#endif // QUIKMAFF_TRIANGULATE_HPP
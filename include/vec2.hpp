@@ -81,16 +81,59 @@ struct vec2 {
         }
     }
 
+    // Compile-time component access
+    template <u32 I>
+    constexpr T get() const
+    {
+        static_assert(I < 2, "Component index out of range for vec2");
+        if constexpr (I == 0) {
+            return x;
+        }
+        else {
+            return y;
+        }
+    }
+
+    /**
+     * @brief Returns the components at the given indices as a new vector.
+     *
+     * Indices are checked at compile time and may repeat, like GLSL swizzles; the result is a
+     * vec2, vec3 or vec4 of T depending on how many are given. Each component is a plain copy,
+     * which the compiler folds into moves or a shuffle, so a swizzle costs no more than writing
+     * the constructor out by hand.
+     *
+     * Example usage:
+     * @code
+     * vec2<f32> v{...};
+     * const auto reversed = v.swizzle<1, 0>();
+     * const auto splat = v.swizzle<0, 0, 0, 0>();
+     * @endcode
+     */
+    template <u32... I>
+    constexpr auto swizzle() const
+    {
+        static_assert(sizeof...(I) >= 2 && sizeof...(I) <= 4, "Swizzles have 2 to 4 components");
+        if constexpr (sizeof...(I) == 2) {
+            return vec2<T>(get<I>()...);
+        }
+        else if constexpr (sizeof...(I) == 3) {
+            return vec3<T>(get<I>()...);
+        }
+        else {
+            return vec4<T>(get<I>()...);
+        }
+    }
+
     // Arithmetic Operators
     constexpr vec2 operator+(const vec2 &other) const { return vec2(x + other.x, y + other.y); }
 
     constexpr vec2 operator-(const vec2 &other) const { return vec2(x - other.x, y - other.y); }
 
-    constexpr vec2 operator*(float scalar) const { return vec2(x * scalar, y * scalar); }
+    constexpr vec2 operator*(T scalar) const { return vec2(x * scalar, y * scalar); }
 
-    constexpr vec2 operator/(float scalar) const
+    constexpr vec2 operator/(T scalar) const
     {
-        if (scalar != 0.0f) {
+        if (scalar != static_cast<T>(0)) {
             return vec2(x / scalar, y / scalar);
         }
         else {
@@ -98,16 +141,20 @@ struct vec2 {
         }
     }
 
-    constexpr float length() const { return qm::sqrt(x * x + y * y); }
+    constexpr qm::RealT<T> length() const
+    {
+        using qm::sqrt;
+        return sqrt(vec2<qm::RealT<T>>(*this).lengthSquared());
+    }
 
-    constexpr float lengthSquared() const { return (x * x + y * y); }
+    constexpr qm::ProductT<T> lengthSquared() const { return (x * x + y * y); }
 
     constexpr void normalize()
     {
-        float len = length();
-        if (len != 0.0f) {
-            x /= len;
-            y /= len;
+        const qm::RealT<T> len = length();
+        if (len != static_cast<qm::RealT<T>>(0)) {
+            x = static_cast<T>(x / len);
+            y = static_cast<T>(y / len);
         }
     }
 
@@ -118,7 +165,7 @@ struct vec2 {
         return result;
     }
 
-    constexpr float dot(const vec2 &other) const { return x * other.x + y * other.y; }
+    constexpr qm::ProductT<T> dot(const vec2 &other) const { return x * other.x + y * other.y; }
 
     // Unary arithmetic operators
     template <IsNumberT A>
@@ -392,9 +439,9 @@ constexpr vec2<T> operator-(const vec2<T> &lhs, const vec2<T> &rhs)
 }
 
 template <IsNumberT T>
-constexpr vec2<T> operator/(const vec2<T> &vec, float scalar)
+constexpr vec2<T> operator/(const vec2<T> &vec, std::type_identity_t<T> scalar)
 {
-    if (scalar != 0.0f) {
+    if (scalar != static_cast<T>(0)) {
         return vec2<T>(vec.x / scalar, vec.y / scalar);
     }
     else {
@@ -403,18 +450,43 @@ constexpr vec2<T> operator/(const vec2<T> &vec, float scalar)
 }
 
 template <IsNumberT T>
-constexpr vec2<T> operator*(const vec2<T> &vec, float scalar)
+constexpr vec2<T> operator*(const vec2<T> &vec, std::type_identity_t<T> scalar)
 {
     return vec2<T>(vec.x * scalar, vec.y * scalar);
 }
 
 // Support commutative multiplication
 template <IsNumberT T>
-constexpr vec2<T> operator*(float scalar, const vec2<T> &vec)
+constexpr vec2<T> operator*(std::type_identity_t<T> scalar, const vec2<T> &vec)
 {
     return vec2<T>(vec.x * scalar, vec.y * scalar);
 }
 
+// A scalar of another type: integer vectors promote (vec2i * 0.5f is a vec2<float>, not a vector
+// scaled by zero) and floating-point vectors keep their precision. See qm::ScaledT.
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec2<qm::ScaledT<T, S>> operator/(const vec2<T> &vec, S scalar)
+{
+    using R = qm::ScaledT<T, S>;
+    return vec2<R>(vec) / static_cast<R>(scalar);
+}
+
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec2<qm::ScaledT<T, S>> operator*(const vec2<T> &vec, S scalar)
+{
+    using R = qm::ScaledT<T, S>;
+    return vec2<R>(vec) * static_cast<R>(scalar);
+}
+
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec2<qm::ScaledT<T, S>> operator*(S scalar, const vec2<T> &vec)
+{
+    return vec * scalar;
+}
+
 // Comparison Operators
 template <IsNumberT T>
 constexpr bool operator==(const vec2<T> &lhs, const vec2<T> &rhs)
@@ -458,23 +530,28 @@ constexpr bool operator>=(const vec2<T> &lhs, const vec2<T> &rhs)
 template <IsNumberT T>
 constexpr vec2<T> xx(const vec2<T> &v)
 {
-    return vec2<T>(v.x, v.x);
+    return v.template swizzle<0, 0>();
 }
 
 template <IsNumberT T>
 constexpr vec2<T> yy(const vec2<T> &v)
 {
-    return vec2<T>(v.y, v.y);
+    return v.template swizzle<1, 1>();
 }
 
 template <IsNumberT T>
 constexpr vec2<T> yx(const vec2<T> &v)
 {
-    return vec2<T>(v.y, v.x);
+    return v.template swizzle<1, 0>();
 }
 
 using vec2f = vec2<float>;
 using vec2i = vec2<int>;
 using vec2u = vec2<unsigned int>;
 
+// Swizzles and conversions return the other vector types, so complete them here, after vec2
+// itself; the include guards stop the cycle
+#include "vec3.hpp"
+#include "vec4.hpp"
+
 #endif // QUIKMAFF_VEC2_HPP
@@ -93,6 +93,39 @@ struct vec3 {
                 return z;
         }
     }
+
+    // Compile-time component access
+    template <u32 I>
+    constexpr T get() const
+    {
+        static_assert(I < 3, "Component index out of range for vec3");
+        if constexpr (I == 0) {
+            return x;
+        }
+        else if constexpr (I == 1) {
+            return y;
+        }
+        else {
+            return z;
+        }
+    }
+
+    // Compile-time swizzle, e.g. v.swizzle<2, 1, 0>() is zyx; see vec2::swizzle
+    template <u32... I>
+    constexpr auto swizzle() const
+    {
+        static_assert(sizeof...(I) >= 2 && sizeof...(I) <= 4, "Swizzles have 2 to 4 components");
+        if constexpr (sizeof...(I) == 2) {
+            return vec2<T>(get<I>()...);
+        }
+        else if constexpr (sizeof...(I) == 3) {
+            return vec3<T>(get<I>()...);
+        }
+        else {
+            return vec4<T>(get<I>()...);
+        }
+    }
+
     // Arithmetic Operators
     constexpr vec3 operator+(const vec3 &other) const
     {
@@ -104,14 +137,11 @@ struct vec3 {
         return vec3(x - other.x, y - other.y, z - other.z);
     }
 
-    constexpr vec3 operator*(float scalar) const
-    {
-        return vec3(x * scalar, y * scalar, z * scalar);
-    }
+    constexpr vec3 operator*(T scalar) const { return vec3(x * scalar, y * scalar, z * scalar); }
 
-    constexpr vec3 operator/(float scalar) const
+    constexpr vec3 operator/(T scalar) const
     {
-        if (scalar != 0.0f) {
+        if (scalar != static_cast<T>(0)) {
             return vec3(x / scalar, y / scalar, z / scalar);
         }
         else {
@@ -119,17 +149,21 @@ struct vec3 {
         }
     }
 
-    constexpr float length() const { return qm::sqrt(x * x + y * y + z * z); }
+    constexpr qm::RealT<T> length() const
+    {
+        using qm::sqrt;
+        return sqrt(vec3<qm::RealT<T>>(*this).lengthSquared());
+    }
 
-    constexpr float lengthSquared() const { return (x * x + y * y + z * z); }
+    constexpr qm::ProductT<T> lengthSquared() const { return (x * x + y * y + z * z); }
 
-    void normalize()
+    constexpr void normalize()
     {
-        float len = length();
-        if (len != 0.0f) {
-            x /= len;
-            y /= len;
-            z /= len;
+        const qm::RealT<T> len = length();
+        if (len != static_cast<qm::RealT<T>>(0)) {
+            x = static_cast<T>(x / len);
+            y = static_cast<T>(y / len);
+            z = static_cast<T>(z / len);
         }
     }
 
@@ -140,13 +174,15 @@ struct vec3 {
         return result;
     }
 
-    constexpr float dot(const vec3 &other) const { return x * other.x + y * other.y + z * other.z; }
+    constexpr qm::ProductT<T> dot(const vec3 &other) const
+    {
+        return x * other.x + y * other.y + z * other.z;
+    }
 
     // Cross Product (Vector Product)
-    vec3<float> cross(const vec3<T> &v) const
+    constexpr vec3 cross(const vec3 &v) const
     {
-        static_assert(IsFloatVec<T, 3>, "Input vector must be a float vector of size 3.");
-        return vec3<float>((y * v.z) - (z * v.y), (z * v.x) - (x * v.z), (x * v.y) - (y * v.x));
+        return vec3((y * v.z) - (z * v.y), (z * v.x) - (x * v.z), (x * v.y) - (y * v.x));
     }
 
     // Unary arithmetic operators
@@ -360,7 +396,7 @@ struct vec3 {
 
     // Bitwise right shift operator
     template <IsIntegerT A>
-    constexpr vec3 &operator>>=(const vec2<A> &v)
+    constexpr vec3 &operator>>=(const vec3<A> &v)
     {
         x >>= v.x;
         y >>= v.y;
@@ -447,9 +483,9 @@ constexpr vec3<T> operator-(const vec3<T> &lhs, const vec3<T> &rhs)
 }
 
 template <IsNumberT T>
-constexpr vec3<T> operator/(const vec3<T> &vec, float scalar)
+constexpr vec3<T> operator/(const vec3<T> &vec, std::type_identity_t<T> scalar)
 {
-    if (scalar != 0.0f) {
+    if (scalar != static_cast<T>(0)) {
         return vec3<T>(vec.x / scalar, vec.y / scalar, vec.z / scalar);
     }
     else {
@@ -458,18 +494,42 @@ constexpr vec3<T> operator/(const vec3<T> &vec, float scalar)
 }
 
 template <IsNumberT T>
-constexpr vec3<T> operator*(const vec3<T> &vec, float scalar)
+constexpr vec3<T> operator*(const vec3<T> &vec, std::type_identity_t<T> scalar)
 {
     return vec3<T>(vec.x * scalar, vec.y * scalar, vec.z * scalar);
 }
 
 // Support commutative multiplication
 template <IsNumberT T>
-constexpr vec3<T> operator*(float scalar, const vec3<T> &vec)
+constexpr vec3<T> operator*(std::type_identity_t<T> scalar, const vec3<T> &vec)
 {
     return vec3<T>(vec.x * scalar, vec.y * scalar, vec.z * scalar);
 }
 
+// A scalar of another type; see qm::ScaledT
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec3<qm::ScaledT<T, S>> operator/(const vec3<T> &vec, S scalar)
+{
+    using R = qm::ScaledT<T, S>;
+    return vec3<R>(vec) / static_cast<R>(scalar);
+}
+
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec3<qm::ScaledT<T, S>> operator*(const vec3<T> &vec, S scalar)
+{
+    using R = qm::ScaledT<T, S>;
+    return vec3<R>(vec) * static_cast<R>(scalar);
+}
+
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec3<qm::ScaledT<T, S>> operator*(S scalar, const vec3<T> &vec)
+{
+    return vec * scalar;
+}
+
 // Comparison Operators
 template <IsNumberT T>
 constexpr bool operator==(const vec3<T> &lhs, const vec3<T> &rhs)
@@ -515,35 +575,33 @@ constexpr bool operator>=(const vec3<T> &lhs, const vec3<T> &rhs)
 template <IsNumberT T>
 constexpr vec3<T> zyx(const vec3<T> &v)
 {
-    return vec3<T>(v.z, v.y, v.x);
-}
-
-template <IsNumberT T>
-constexpr vec3<T> wxy(const vec3<T> &v)
-{
-    return vec3<T>(v.w, v.x, v.y);
+    return v.template swizzle<2, 1, 0>();
 }
 
 template <IsNumberT T>
 constexpr vec3<T> xxx(const vec3<T> &v)
 {
-    return vec3<T>(v.x, v.x, v.x);
+    return v.template swizzle<0, 0, 0>();
 }
 
 template <IsNumberT T>
 constexpr vec3<T> yyy(const vec3<T> &v)
 {
-    return vec3<T>(v.y, v.y, v.y);
+    return v.template swizzle<1, 1, 1>();
 }
 
 template <IsNumberT T>
 constexpr vec3<T> zzz(const vec3<T> &v)
 {
-    return vec3<T>(v.z, v.z, v.z);
+    return v.template swizzle<2, 2, 2>();
 }
 
 using vec3f = vec3<float>;
 using vec3i = vec3<int>;
 using vec3u = vec3<unsigned int>;
 
+// Complete the other vector types after this one; see vec2.hpp
+#include "vec2.hpp"
+#include "vec4.hpp"
+
 #endif // QUIKMAFF_VEC3_HPP
\ No newline at end of file
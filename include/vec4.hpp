@@ -143,6 +143,41 @@ struct vec4 {
         }
     }
 
+    // Compile-time component access
+    template <u32 I>
+    constexpr T get() const
+    {
+        static_assert(I < 4, "Component index out of range for vec4");
+        if constexpr (I == 0) {
+            return x;
+        }
+        else if constexpr (I == 1) {
+            return y;
+        }
+        else if constexpr (I == 2) {
+            return z;
+        }
+        else {
+            return w;
+        }
+    }
+
+    // Compile-time swizzle, e.g. v.swizzle<3, 2, 1, 0>() is wzyx; see vec2::swizzle
+    template <u32... I>
+    constexpr auto swizzle() const
+    {
+        static_assert(sizeof...(I) >= 2 && sizeof...(I) <= 4, "Swizzles have 2 to 4 components");
+        if constexpr (sizeof...(I) == 2) {
+            return vec2<T>(get<I>()...);
+        }
+        else if constexpr (sizeof...(I) == 3) {
+            return vec3<T>(get<I>()...);
+        }
+        else {
+            return vec4<T>(get<I>()...);
+        }
+    }
+
     // Arithmetic Operators
     constexpr vec4 operator+(const vec4 &other) const
     {
@@ -154,14 +189,14 @@ struct vec4 {
         return vec4(x - other.x, y - other.y, z - other.z, w - other.w);
     }
 
-    constexpr vec4 operator*(float scalar) const
+    constexpr vec4 operator*(T scalar) const
     {
         return vec4(x * scalar, y * scalar, z * scalar, w * scalar);
     }
 
-    constexpr vec4 operator/(float scalar) const
+    constexpr vec4 operator/(T scalar) const
     {
-        if (scalar != 0.0f) {
+        if (scalar != static_cast<T>(0)) {
             return vec4(x / scalar, y / scalar, z / scalar, w / scalar);
         }
         else {
@@ -169,18 +204,22 @@ struct vec4 {
         }
     }
 
-    constexpr float length() const { return qm::sqrt(x * x + y * y + z * z + w * w); }
+    constexpr qm::RealT<T> length() const
+    {
+        using qm::sqrt;
+        return sqrt(vec4<qm::RealT<T>>(*this).lengthSquared());
+    }
 
-    constexpr float lengthSquared() const { return (x * x + y * y + z * z + w * w); }
+    constexpr qm::ProductT<T> lengthSquared() const { return (x * x + y * y + z * z + w * w); }
 
     constexpr void normalize()
     {
-        float len = length();
-        if (len != 0.0f) {
-            x /= len;
-            y /= len;
-            z /= len;
-            w /= len;
+        const qm::RealT<T> len = length();
+        if (len != static_cast<qm::RealT<T>>(0)) {
+            x = static_cast<T>(x / len);
+            y = static_cast<T>(y / len);
+            z = static_cast<T>(z / len);
+            w = static_cast<T>(w / len);
         }
     }
 
@@ -192,7 +231,7 @@ struct vec4 {
     }
 
     template <IsNumberT A>
-    constexpr float dot(const vec4<A> &other) const
+    constexpr qm::ProductT<T, A> dot(const vec4<A> &other) const
     {
         return x * other.x + y * other.y + z * other.z + w * other.w;
     }
@@ -524,13 +563,13 @@ constexpr vec4<T> operator+(const vec4<T> &lhs, const vec4<T> &rhs)
 template <IsNumberT T>
 constexpr vec4<T> operator-(const vec4<T> &lhs, const vec4<T> &rhs)
 {
-    return vec4<T>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.x - rhs.z, lhs.w - rhs.w);
+    return vec4<T>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
 }
 
 template <IsNumberT T>
-constexpr vec4<T> operator/(const vec4<T> &vec, float scalar)
+constexpr vec4<T> operator/(const vec4<T> &vec, std::type_identity_t<T> scalar)
 {
-    if (scalar != 0.0f) {
+    if (scalar != static_cast<T>(0)) {
         return vec4<T>(vec.x / scalar, vec.y / scalar, vec.z / scalar, vec.w / scalar);
     }
     else {
@@ -539,18 +578,42 @@ constexpr vec4<T> operator/(const vec4<T> &vec, float scalar)
 }
 
 template <IsNumberT T>
-constexpr vec4<T> operator*(const vec4<T> &vec, float scalar)
+constexpr vec4<T> operator*(const vec4<T> &vec, std::type_identity_t<T> scalar)
 {
     return vec4<T>(vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar);
 }
 
 // Support commutative multiplication
 template <IsNumberT T>
-constexpr vec4<T> operator*(float scalar, const vec4<T> &vec)
+constexpr vec4<T> operator*(std::type_identity_t<T> scalar, const vec4<T> &vec)
 {
     return vec4<T>(vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar);
 }
 
+// A scalar of another type; see qm::ScaledT
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec4<qm::ScaledT<T, S>> operator/(const vec4<T> &vec, S scalar)
+{
+    using R = qm::ScaledT<T, S>;
+    return vec4<R>(vec) / static_cast<R>(scalar);
+}
+
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec4<qm::ScaledT<T, S>> operator*(const vec4<T> &vec, S scalar)
+{
+    using R = qm::ScaledT<T, S>;
+    return vec4<R>(vec) * static_cast<R>(scalar);
+}
+
+template <IsNumberT T, IsNumberT S>
+    requires(!std::is_same_v<T, S>)
+constexpr vec4<qm::ScaledT<T, S>> operator*(S scalar, const vec4<T> &vec)
+{
+    return vec * scalar;
+}
+
 // Comparison Operators
 template <IsNumberT T>
 constexpr bool operator==(const vec4<T> &lhs, const vec4<T> &rhs)
@@ -598,35 +661,39 @@ constexpr bool operator>=(const vec4<T> &lhs, const vec4<T> &rhs)
 template <IsNumberT T>
 constexpr vec4<T> wzyx(const vec4<T> &v)
 {
-    return vec4<T>(v.w, v.z, v.x, v.y);
+    return v.template swizzle<3, 2, 1, 0>();
 }
 
 template <IsNumberT T>
 constexpr vec4<T> xxxx(const vec4<T> &v)
 {
-    return vec4<T>(v.x, v.x, v.x, v.x);
+    return v.template swizzle<0, 0, 0, 0>();
 }
 
 template <IsNumberT T>
 constexpr vec4<T> yyyy(const vec4<T> &v)
 {
-    return vec4<T>(v.y, v.y, v.y, v.y);
+    return v.template swizzle<1, 1, 1, 1>();
 }
 
 template <IsNumberT T>
 constexpr vec4<T> zzzz(const vec4<T> &v)
 {
-    return vec4<T>(v.z, v.z, v.z, v.z);
+    return v.template swizzle<2, 2, 2, 2>();
 }
 
 template <IsNumberT T>
 constexpr vec4<T> wwww(const vec4<T> &v)
 {
-    return vec4<T>(v.w, v.w, v.w, v.w);
+    return v.template swizzle<3, 3, 3, 3>();
 }
 
 using vec4f = vec4<float>;
 using vec4i = vec4<int>;
 using vec4u = vec4<unsigned int>;
 
+// Complete the other vector types after this one; see vec2.hpp
+#include "vec2.hpp"
+#include "vec3.hpp"
+
 #endif // QUIKMAFF_VEC4_HPP
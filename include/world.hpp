@@ -0,0 +1,164 @@
+#ifndef QUIKMAFF_WORLD_HPP
+#define QUIKMAFF_WORLD_HPP
+
+#include <span>
+
+#include "vec2.hpp"
+#include "vec3.hpp"
+
+#ifdef QM_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * Large-world coordinate helpers.
+ *
+ * Positions in large worlds are kept as f64 so that detail far from the world origin survives,
+ * while rendering and physics want f32. Subtracting a camera (or any local origin) in f64 before
+ * narrowing keeps the error relative to the distance from the camera rather than from the world
+ * origin: an object 10 km away from the origin but 1 m from the camera keeps sub-micrometre
+ * precision instead of the millimetre steps a float world position has there.
+ *
+ * The span overloads convert whole buffers; with QM_AVX2 they subtract and narrow four doubles per
+ * instruction and give the same bits as the scalar functions.
+ */
+
+namespace qm {
+
+/**
+ * @brief Returns a world position relative to the camera, narrowed to f32.
+ *
+ * @param position The world position.
+ * @param camera The camera (local origin) position.
+ * @return position - camera, subtracted in f64 and then rounded to f32.
+ *
+ * Example usage:
+ * @code
+ * const vec3<f64> ship(6.4e6, 12.5, -3.2e5);
+ * const vec3<f32> offset = qm::toCameraRelative(ship, cameraPosition);
+ * @endcode
+ */
+inline vec3<f32> toCameraRelative(const vec3<f64> &position, const vec3<f64> &camera)
+{
+    return vec3<f32>(static_cast<f32>(position.x - camera.x),
+                     static_cast<f32>(position.y - camera.y),
+                     static_cast<f32>(position.z - camera.z));
+}
+
+/**
+ * @brief Returns a 2D world position relative to the camera, narrowed to f32.
+ *
+ * @param position The world position.
+ * @param camera The camera (local origin) position.
+ * @return position - camera, subtracted in f64 and then rounded to f32.
+ */
+inline vec2<f32> toCameraRelative(const vec2<f64> &position, const vec2<f64> &camera)
+{
+    return vec2<f32>(static_cast<f32>(position.x - camera.x),
+                     static_cast<f32>(position.y - camera.y));
+}
+
+/**
+ * @brief Converts a camera-relative offset back to a world position.
+ *
+ * @param offset The offset from the camera, e.g. a picked point.
+ * @param camera The camera (local origin) position.
+ * @return camera + offset in f64.
+ */
+inline vec3<f64> fromCameraRelative(const vec3<f32> &offset, const vec3<f64> &camera)
+{
+    return vec3<f64>(camera.x + static_cast<f64>(offset.x), camera.y + static_cast<f64>(offset.y),
+                     camera.z + static_cast<f64>(offset.z));
+}
+
+/**
+ * @brief Converts a 2D camera-relative offset back to a world position.
+ *
+ * @param offset The offset from the camera.
+ * @param camera The camera (local origin) position.
+ * @return camera + offset in f64.
+ */
+inline vec2<f64> fromCameraRelative(const vec2<f32> &offset, const vec2<f64> &camera)
+{
+    return vec2<f64>(camera.x + static_cast<f64>(offset.x), camera.y + static_cast<f64>(offset.y));
+}
+
+/**
+ * @brief Converts a buffer of world positions to camera-relative f32 offsets.
+ *
+ * Each output is toCameraRelative(positions[i], camera).
+ *
+ * @param positions The world positions.
+ * @param camera The camera (local origin) position.
+ * @param out Receives positions.size() offsets, e.g. a vertex or instance buffer.
+ *
+ * Example usage:
+ * @code
+ * std::vector<vec3<f32>> instances(positions.size());
+ * qm::toCameraRelative(positions, cameraPosition, instances);
+ * @endcode
+ */
+inline void toCameraRelative(std::span<const vec3<f64>> positions, const vec3<f64> &camera,
+                             std::span<vec3<f32>> out)
+{
+    QM_ASSERT(out.size() >= positions.size());
+    const std::size_t count = positions.size();
+    std::size_t i = 0;
+#ifdef QM_AVX2
+    static_assert(sizeof(vec3<f64>) == 3 * sizeof(f64) && sizeof(vec3<f32>) == 3 * sizeof(f32));
+    // Four positions are twelve doubles; the camera repeats every three lanes across the loads
+    const __m256d origin0 = _mm256_setr_pd(camera.x, camera.y, camera.z, camera.x);
+    const __m256d origin1 = _mm256_setr_pd(camera.y, camera.z, camera.x, camera.y);
+    const __m256d origin2 = _mm256_setr_pd(camera.z, camera.x, camera.y, camera.z);
+    const f64 *in = reinterpret_cast<const f64 *>(positions.data());
+    f32 *dst = reinterpret_cast<f32 *>(out.data());
+    for (; i + 4 <= count; i += 4) {
+        const f64 *src = in + 3 * i;
+        const __m128 a = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src), origin0));
+        const __m128 b = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src + 4), origin1));
+        const __m128 c = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src + 8), origin2));
+        _mm_storeu_ps(dst + 3 * i, a);
+        _mm_storeu_ps(dst + 3 * i + 4, b);
+        _mm_storeu_ps(dst + 3 * i + 8, c);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = toCameraRelative(positions[i], camera);
+    }
+}
+
+/**
+ * @brief Converts a buffer of 2D world positions to camera-relative f32 offsets.
+ *
+ * Each output is toCameraRelative(positions[i], camera).
+ *
+ * @param positions The world positions.
+ * @param camera The camera (local origin) position.
+ * @param out Receives positions.size() offsets.
+ */
+inline void toCameraRelative(std::span<const vec2<f64>> positions, const vec2<f64> &camera,
+                             std::span<vec2<f32>> out)
+{
+    QM_ASSERT(out.size() >= positions.size());
+    const std::size_t count = positions.size();
+    std::size_t i = 0;
+#ifdef QM_AVX2
+    static_assert(sizeof(vec2<f64>) == 2 * sizeof(f64) && sizeof(vec2<f32>) == 2 * sizeof(f32));
+    const __m256d origin = _mm256_setr_pd(camera.x, camera.y, camera.x, camera.y);
+    const f64 *in = reinterpret_cast<const f64 *>(positions.data());
+    f32 *dst = reinterpret_cast<f32 *>(out.data());
+    for (; i + 4 <= count; i += 4) {
+        const __m128 a = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + 2 * i), origin));
+        const __m128 b = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + 2 * i + 4), origin));
+        _mm_storeu_ps(dst + 2 * i, a);
+        _mm_storeu_ps(dst + 2 * i + 4, b);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = toCameraRelative(positions[i], camera);
+    }
+}
+
+} // namespace qm
+
+#endif // QUIKMAFF_WORLD_HPP
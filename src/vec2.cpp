@@ -1 +1,6 @@
 #include "vec2.hpp"
+
+// The header must be usable on its own, including swizzles to the other vector types
+static_assert(vec2<int>(1, 2).swizzle<1, 0>().x == 2);
+static_assert(vec2<int>(1, 2).swizzle<0, 1, 0>().z == 1);
+static_assert(vec2<int>(1, 2).swizzle<1, 1, 0, 0>().w == 1);
@@ -1,7 +1,9 @@
 #include "vec3.hpp"
 
-#include "vec2.hpp"
-#include "vec4.hpp"
+// Swizzles to every vector type with only this header included
+static_assert(vec3<int>(1, 2, 3).swizzle<0, 1>().y == 2);
+static_assert(vec3<int>(1, 2, 3).swizzle<2, 0, 1>().x == 3);
+static_assert(vec3<int>(1, 2, 3).swizzle<2, 2, 1, 0>().w == 1);
 
 /*
 constexpr Vec3::Vec3(const Vec2 &vec2, float z) : x(vec2.x), y(vec2.y), z(z) {}
@@ -15,24 +17,4 @@ constexpr Vec3::Vec3(double valueX, double valueY, double valueZ)
 {
 }
 
-Vec2 Vec3::swizzle(int index1, int index2) const
-{
-    switch (index1) {
-        case 0:
-            return {x, y};
-        case 1:
-            return {y, z};
-        case 2:
-            return {x, z};
-        default:
-            // Handle invalid swizzle indices
-            throw std::invalid_argument("Invalid swizzle indices for Vec3");
-    }
-}
-
-Vec3 Vec3::swizzle(int index1, int index2, int index3) const
-{
-    return {x, y, z}; // Swizzle to the same vector (no change)
-}
-
 */